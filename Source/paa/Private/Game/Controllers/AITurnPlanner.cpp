@@ -0,0 +1,455 @@
+#include "Game/Controllers/AITurnPlanner.h"
+
+#include "Async/ParallelFor.h"
+#include "Game/Managers/BattleManager.h"
+#include "Systems/BattleRules.h"
+
+namespace
+{
+	constexpr int32 MaxMoveCandidates = 6; // Destinations searched per unit besides staying, best first.
+	constexpr int32 MaxNodesPerWorker = 200000; // Past this size a tree stops growing and only refines its statistics.
+	constexpr double ExplorationWeight = 0.7; // UCB1 exploration constant, for values roughly in [-1, 1].
+	constexpr double AliveBonus = 20.0; // Value of a unit being alive, on top of its life points.
+	constexpr double ApproachWeight = 0.5; // Penalty per tile an AI unit stands beyond attack range of its nearest enemy.
+	constexpr double ThreatWeight = 0.25; // Share of an enemy's average damage counted against each AI unit it can reach.
+	constexpr int32 RankGapWeight = 16; // Rank penalty per tile beyond attack range, against threat and support in half damage points.
+
+	/** One AI unit's option: where to stand and whom to attack. */
+	struct FUnitOption
+	{
+		int32 MoveCell = INDEX_NONE; // Flat index of the destination (the unit's own tile to stay).
+		int32 Target = INDEX_NONE; // Index of the attacked unit, or INDEX_NONE for no attack.
+
+		bool operator==(const FUnitOption& Other) const { return MoveCell == Other.MoveCell && Target == Other.Target; }
+	};
+
+	/** A node of a search tree; its children are the options of the next acting unit. */
+	struct FSearchNode
+	{
+		FUnitOption Option; // The option leading to this node.
+		int32 FirstChild = INDEX_NONE; // Index of the first child in the node pool; children are contiguous.
+		int32 NumChildren = 0; // Number of children.
+		int32 Visits = 0; // Number of iterations through this node.
+		double TotalValue = 0.0; // Sum of the values of those iterations.
+		bool bExpanded = false; // Whether the children have been created.
+	};
+
+	/** Everything one worker owns; workers share nothing but the read-only root state. */
+	struct FSearchWorker
+	{
+		TArray<FSearchNode> Nodes; // The node pool; index 0 is the root.
+		FBattleState State; // The state of the current iteration, reassigned from the root each time.
+		FBattleRules Rules; // Rules with their own search buffers.
+		FMatchRng Random; // Draws the damage seed of every iteration.
+		TArray<FGridCoord> Moves; // Reusable destination buffer.
+		TArray<TPair<int32, int32>> ScoredCells; // Reusable (score, cell) buffer.
+		FGridBitboard FiringTiles; // Reusable set of the tiles the ranked unit could shoot an enemy from.
+		const FInfluenceMap* Influence = nullptr; // The influence map of the root state, shared read-only by every worker.
+		TArray<FUnitOption> Options; // Reusable option buffer.
+		TArray<int32> Path; // The nodes visited by the current iteration.
+		int64 Iterations = 0; // Number of iterations run.
+	};
+
+	/** @return The Manhattan distance from a tile to the nearest living enemy of a unit, or MAX_int32 if none is left. */
+	int32 NearestEnemyDistance(const FBattleState& State, const int32 Unit, const FGridCoord& Tile)
+	{
+		const FBattleUnits& Units = State.Units;
+		int32 Nearest = MAX_int32;
+
+		for (int32 Other = 0; Other < Units.Num(); ++Other)
+		{
+			if (Units.IsAlive(Other) && Units.IsPlayer(Other) != Units.IsPlayer(Unit))
+			{
+				Nearest = FMath::Min(Nearest, Tile.Distance(Units.Position[Other]));
+			}
+		}
+
+		return Nearest;
+	}
+
+	/**
+	 * Ranks the destinations of a unit, staying included, and keeps the most promising ones in ScoredCells.
+	 * A destination is better the fewer tiles it lies beyond attack range of the nearest enemy, then the less the enemies
+	 * threaten it and the more allies back it up. Tiles in range of an enemy but out of its sight count as one tile short.
+	 * Every destination is scored in one pass over the influence layers of the turn's starting position; the search
+	 * itself judges the outcomes, so the ranking only needs a rough order.
+	 */
+	void RankMoveCells(FSearchWorker& Worker, const FBattleState& State, const int32 Unit)
+	{
+		const FBattleUnits& Units = State.Units;
+		const FGridCoord Stay = Units.Position[Unit];
+
+		Worker.Rules.GetMoves(State, Unit, Worker.Moves);
+		Worker.Moves.Add(Stay);
+
+		// Every tile an enemy can be shot from, gathered for all destinations at once from the cached sight rows.
+		Worker.FiringTiles.Init(State.Grid.SizeX, State.Grid.SizeY);
+		for (int32 Other = 0; Other < Units.Num(); ++Other)
+		{
+			if (Units.IsAlive(Other) && Units.IsPlayer(Other) != Units.IsPlayer(Unit))
+			{
+				State.AddVisibleArea(Units.Position[Other], Units.AttackRange[Unit], Worker.FiringTiles);
+			}
+		}
+
+		const FInfluenceMap& Influence = *Worker.Influence;
+
+		Worker.ScoredCells.Reset();
+		for (const FGridCoord& Tile : Worker.Moves)
+		{
+			const int32 Cell = State.Grid.ToIndex(Tile);
+			int32 Gap = 0;
+
+			if (!Worker.FiringTiles.Get(Tile))
+			{
+				// Walking distance to the nearest enemy; Manhattan distance where walls cut the tile off.
+				const int32 Walk = Influence.GetTargetDistance(Cell);
+				const int32 Nearest = Walk != INDEX_NONE ? Walk : NearestEnemyDistance(State, Unit, Tile);
+				Gap = Nearest == MAX_int32 ? 0 : FMath::Max(1, Nearest - Units.AttackRange[Unit]);
+			}
+
+			Worker.ScoredCells.Add({ Gap * RankGapWeight + Influence.GetThreat(Cell) - Influence.GetSupport(Cell, Unit), Cell });
+		}
+
+		Worker.ScoredCells.Sort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+		{
+			return A.Key < B.Key || (A.Key == B.Key && A.Value < B.Value);
+		});
+
+		// Keep the best destinations, and staying put in any case.
+		const int32 StayCell = State.Grid.ToIndex(Stay);
+		const int32 StayRank = Worker.ScoredCells.IndexOfByPredicate([StayCell](const TPair<int32, int32>& Scored) { return Scored.Value == StayCell; });
+		const TPair<int32, int32> StayScored = Worker.ScoredCells[StayRank];
+
+		Worker.ScoredCells.SetNum(FMath::Min(Worker.ScoredCells.Num(), MaxMoveCandidates + 1), EAllowShrinking::No);
+		if (StayRank > MaxMoveCandidates) Worker.ScoredCells.Add(StayScored);
+	}
+
+	/** Collects the options of a unit: each kept destination, with every attack possible from it and with no attack. */
+	void CollectOptions(FSearchWorker& Worker, const FBattleState& State, const int32 Unit)
+	{
+		const FBattleUnits& Units = State.Units;
+
+		RankMoveCells(Worker, State, Unit);
+
+		Worker.Options.Reset();
+		for (const TPair<int32, int32>& Scored : Worker.ScoredCells)
+		{
+			const FGridCoord Tile = State.Grid.ToCoord(Scored.Value);
+
+			for (int32 Other = 0; Other < Units.Num(); ++Other)
+			{
+				if (Units.IsAlive(Other) && Units.IsPlayer(Other) != Units.IsPlayer(Unit) &&
+					Tile.Distance(Units.Position[Other]) <= Units.AttackRange[Unit] && State.HasLineOfSight(Tile, Units.Position[Other]))
+				{
+					Worker.Options.Add({ Scored.Value, Other });
+				}
+			}
+
+			Worker.Options.Add({ Scored.Value, INDEX_NONE });
+		}
+	}
+
+	/** @return The option of the rollout policy: the best ranked destination, attacking the weakest enemy in range. */
+	FUnitOption DefaultOption(FSearchWorker& Worker, const FBattleState& State, const int32 Unit)
+	{
+		const FBattleUnits& Units = State.Units;
+
+		RankMoveCells(Worker, State, Unit);
+
+		FUnitOption Option;
+		Option.MoveCell = Worker.ScoredCells[0].Value;
+
+		const FGridCoord Tile = State.Grid.ToCoord(Option.MoveCell);
+		for (int32 Other = 0; Other < Units.Num(); ++Other)
+		{
+			if (Units.IsAlive(Other) && Units.IsPlayer(Other) != Units.IsPlayer(Unit) &&
+				Tile.Distance(Units.Position[Other]) <= Units.AttackRange[Unit] && State.HasLineOfSight(Tile, Units.Position[Other]) &&
+				(Option.Target == INDEX_NONE || Units.LifePoints[Other] < Units.LifePoints[Option.Target]))
+			{
+				Option.Target = Other;
+			}
+		}
+
+		return Option;
+	}
+
+	/** Plays an option. Options that became illegal in this iteration's damage rolls degrade to staying or not attacking. */
+	void ApplyOption(FBattleState& State, const int32 Unit, const FUnitOption& Option)
+	{
+		FBattleUndo Undo;
+
+		// Moves replay identically in every iteration; only a death rolled differently can change the board around them.
+		if (FBattleRules::CanAct(State, Unit) && (State.Units.Position[Unit] == State.Grid.ToCoord(Option.MoveCell) || !State.Occupied[Option.MoveCell]))
+		{
+			FBattleRules::ApplyMove(State, Unit, State.Grid.ToCoord(Option.MoveCell), Undo);
+		}
+
+		if (Option.Target != INDEX_NONE && FBattleRules::CanAttack(State, Unit, Option.Target))
+		{
+			FBattleRules::ApplyAttack(State, Unit, Option.Target, Undo);
+		}
+	}
+
+	/**
+	 * Scores a state from the AI's point of view: life and survival of both teams,
+	 * how far AI units stand from striking range and how exposed they are to the player's next turn.
+	 * @return The score divided by Scale, roughly in [-1, 1].
+	 */
+	double Evaluate(const FBattleState& State, const double Scale)
+	{
+		const FBattleUnits& Units = State.Units;
+		double Score = 0.0;
+
+		for (int32 Unit = 0; Unit < Units.Num(); ++Unit)
+		{
+			if (!Units.IsAlive(Unit)) continue;
+
+			const double Sign = Units.IsPlayer(Unit) ? -1.0 : 1.0;
+			Score += Sign * (Units.LifePoints[Unit] + AliveBonus);
+
+			if (Units.IsPlayer(Unit)) continue;
+
+			const int32 Nearest = NearestEnemyDistance(State, Unit, Units.Position[Unit]);
+			if (Nearest != MAX_int32) Score -= ApproachWeight * FMath::Max(0, Nearest - Units.AttackRange[Unit]);
+
+			for (int32 Other = 0; Other < Units.Num(); ++Other)
+			{
+				if (Units.IsAlive(Other) && Units.IsPlayer(Other) &&
+					Units.Position[Unit].Distance(Units.Position[Other]) <= Units.MovementRange[Other] + Units.AttackRange[Other])
+				{
+					Score -= ThreatWeight * 0.5 * (Units.DamageMin[Other] + Units.DamageMax[Other]);
+				}
+			}
+		}
+
+		return Score / Scale;
+	}
+
+	/** @return The child to descend into: the first unvisited one, otherwise the one with the best UCB1 bound. */
+	int32 SelectChild(const TArray<FSearchNode>& Nodes, const int32 NodeIndex)
+	{
+		const FSearchNode& Node = Nodes[NodeIndex];
+		const double LogVisits = FMath::Loge(double(FMath::Max(1, Node.Visits)));
+
+		int32 Best = Node.FirstChild;
+		double BestBound = -TNumericLimits<double>::Max();
+
+		for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+		{
+			if (Nodes[Child].Visits == 0) return Child;
+
+			const double Bound = Nodes[Child].TotalValue / Nodes[Child].Visits + ExplorationWeight * FMath::Sqrt(LogVisits / Nodes[Child].Visits);
+			if (Bound > BestBound)
+			{
+				BestBound = Bound;
+				Best = Child;
+			}
+		}
+
+		return Best;
+	}
+
+	/**
+	 * Runs one iteration: replays the tree's options from the root with fresh damage rolls, expands the first
+	 * unexpanded node, completes the turn with the rollout policy and backs the value up the visited nodes.
+	 */
+	void RunIteration(FSearchWorker& Worker, const FBattleState& Root, const TArray<int32>& Actors, const double Scale)
+	{
+		FBattleState& State = Worker.State;
+		State = Root;
+		State.Random.Initialize(Worker.Random.Next());
+
+		Worker.Path.Reset();
+		Worker.Path.Add(0);
+
+		int32 NodeIndex = 0;
+		int32 Depth = 0;
+
+		while (Depth < Actors.Num())
+		{
+			const int32 Unit = Actors[Depth];
+
+			if (!Worker.Nodes[NodeIndex].bExpanded)
+			{
+				if (Worker.Nodes.Num() >= MaxNodesPerWorker) break;
+
+				CollectOptions(Worker, State, Unit);
+
+				const int32 FirstChild = Worker.Nodes.Num();
+				for (const FUnitOption& Option : Worker.Options)
+				{
+					Worker.Nodes.AddDefaulted_GetRef().Option = Option;
+				}
+
+				FSearchNode& Node = Worker.Nodes[NodeIndex];
+				Node.FirstChild = FirstChild;
+				Node.NumChildren = Worker.Options.Num();
+				Node.bExpanded = true;
+			}
+
+			const int32 Child = SelectChild(Worker.Nodes, NodeIndex);
+			const bool bFirstVisit = Worker.Nodes[Child].Visits == 0;
+
+			ApplyOption(State, Unit, Worker.Nodes[Child].Option);
+			Worker.Path.Add(Child);
+			NodeIndex = Child;
+			++Depth;
+
+			if (bFirstVisit) break;
+		}
+
+		// Roll out the units below the tree.
+		for (; Depth < Actors.Num(); ++Depth)
+		{
+			ApplyOption(State, Actors[Depth], DefaultOption(Worker, State, Actors[Depth]));
+		}
+
+		const double Value = Evaluate(State, Scale);
+		for (const int32 Visited : Worker.Path)
+		{
+			Worker.Nodes[Visited].Visits++;
+			Worker.Nodes[Visited].TotalValue += Value;
+		}
+
+		Worker.Iterations++;
+	}
+
+	/** Adds the statistics of a subtree of another worker to the matching subtree of Dest. */
+	void MergeNode(TArray<FSearchNode>& Dest, const int32 DestIndex, const TArray<FSearchNode>& Source, const int32 SourceIndex)
+	{
+		Dest[DestIndex].Visits += Source[SourceIndex].Visits;
+		Dest[DestIndex].TotalValue += Source[SourceIndex].TotalValue;
+
+		if (!Dest[DestIndex].bExpanded || !Source[SourceIndex].bExpanded) return;
+
+		const FSearchNode& SourceNode = Source[SourceIndex];
+		for (int32 SourceChild = SourceNode.FirstChild; SourceChild < SourceNode.FirstChild + SourceNode.NumChildren; ++SourceChild)
+		{
+			const FSearchNode& DestNode = Dest[DestIndex];
+			for (int32 DestChild = DestNode.FirstChild; DestChild < DestNode.FirstChild + DestNode.NumChildren; ++DestChild)
+			{
+				if (Dest[DestChild].Option == Source[SourceChild].Option)
+				{
+					MergeNode(Dest, DestChild, Source, SourceChild);
+					break;
+				}
+			}
+		}
+	}
+}
+
+FBattleState FAITurnPlanner::Capture(const UBattleManager& BattleManager, const uint32 Seed, TArray<TWeakObjectPtr<ABaseUnit>>& OutHandles)
+{
+	FBattleState State = BattleManager.GetBattleState();
+	State.bPlayerTurn = false;
+	State.Random.Initialize(Seed);
+
+	OutHandles.Init(nullptr, State.Units.Num());
+	for (const bool bPlayerTeam : { true, false })
+	{
+		for (const FUnitEntry& Entry : BattleManager.GetUnits(bPlayerTeam))
+		{
+			OutHandles[Entry.Index] = Entry.Unit;
+		}
+	}
+
+	return State;
+}
+
+FAITurnPlan FAITurnPlanner::Plan(const FBattleState& State, const FInfluenceMap& Influence, const FAIPlannerSettings& Settings)
+{
+	const double Begin = FPlatformTime::Seconds();
+	FAITurnPlan Plan;
+
+	// Rank destinations on the acting team's map; a map built for the other team (or not at all) is rebuilt here.
+	FInfluenceMap OwnInfluence;
+	const FInfluenceMap* RootInfluence = &Influence;
+	if (!Influence.IsBuilt() || Influence.IsPlayerTeam() != State.bPlayerTurn)
+	{
+		OwnInfluence.Build(State, State.bPlayerTurn);
+		RootInfluence = &OwnInfluence;
+	}
+
+	// The AI units that can still act, in registry order; tree level N decides unit N.
+	TArray<int32> Actors;
+	double Scale = 0.0;
+	for (int32 Unit = 0; Unit < State.Units.Num(); ++Unit)
+	{
+		if (FBattleRules::CanAct(State, Unit)) Actors.Add(Unit);
+		if (State.Units.IsAlive(Unit)) Scale += State.Units.LifePoints[Unit] + AliveBonus;
+	}
+
+	if (Actors.IsEmpty()) return Plan;
+
+	// 1. Every worker grows its own tree until the budget runs out.
+	const double Deadline = Begin + Settings.BudgetSeconds;
+	TArray<FSearchWorker> Workers;
+	Workers.SetNum(FMath::Max(1, Settings.NumWorkers));
+
+	ParallelFor(Workers.Num(), [&](const int32 WorkerIndex)
+	{
+		FSearchWorker& Worker = Workers[WorkerIndex];
+		Worker.Random.Initialize(Settings.Seed, WorkerIndex);
+		Worker.Influence = RootInfluence;
+		Worker.Nodes.AddDefaulted();
+
+		do
+		{
+			RunIteration(Worker, State, Actors, FMath::Max(Scale, 1.0));
+		}
+		while (Settings.IterationsPerWorker > 0 ? Worker.Iterations < Settings.IterationsPerWorker : FPlatformTime::Seconds() < Deadline);
+	}, EParallelForFlags::Unbalanced);
+
+	// 2. Merge the statistics into the largest tree.
+	int32 Largest = 0;
+	for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+	{
+		Plan.Iterations += Workers[WorkerIndex].Iterations;
+		Plan.Nodes += Workers[WorkerIndex].Nodes.Num();
+		if (Workers[WorkerIndex].Nodes.Num() > Workers[Largest].Nodes.Num()) Largest = WorkerIndex;
+	}
+
+	FSearchWorker& Result = Workers[Largest];
+	for (int32 WorkerIndex = 0; WorkerIndex < Workers.Num(); ++WorkerIndex)
+	{
+		if (WorkerIndex != Largest) MergeNode(Result.Nodes, 0, Workers[WorkerIndex].Nodes, 0);
+	}
+
+	// 3. Follow the most visited options; units below the tree fall back to the rollout policy.
+	FBattleState Line = State;
+	int32 NodeIndex = 0;
+
+	for (const int32 Unit : Actors)
+	{
+		FUnitOption Option;
+
+		if (NodeIndex != INDEX_NONE && Result.Nodes[NodeIndex].bExpanded)
+		{
+			const FSearchNode& Node = Result.Nodes[NodeIndex];
+			int32 Best = Node.FirstChild;
+			for (int32 Child = Node.FirstChild; Child < Node.FirstChild + Node.NumChildren; ++Child)
+			{
+				if (Result.Nodes[Child].Visits > Result.Nodes[Best].Visits) Best = Child;
+			}
+
+			Option = Result.Nodes[Best].Option;
+			NodeIndex = Best;
+		}
+		else
+		{
+			Option = DefaultOption(Result, Line, Unit);
+			NodeIndex = INDEX_NONE;
+		}
+
+		FPlannedAction& Action = Plan.Actions.AddDefaulted_GetRef();
+		Action.UnitIndex = Unit;
+		Action.TargetIndex = Option.Target;
+		if (Line.Grid.ToCoord(Option.MoveCell) != Line.Units.Position[Unit]) Action.MoveTo = Line.Grid.ToCoord(Option.MoveCell);
+
+		ApplyOption(Line, Unit, Option);
+	}
+
+	Plan.PlanningSeconds = FPlatformTime::Seconds() - Begin;
+	return Plan;
+}
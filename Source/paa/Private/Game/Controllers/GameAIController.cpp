@@ -1,8 +1,29 @@
 #include "Game/Controllers/GameAIController.h"
 
+#include "Async/Async.h"
 #include "Game/Controllers/GamePlayerController.h"
 #include "Game/Managers/BattleManager.h"
 #include "Game/Managers/PlacementManager.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+	TAutoConsoleVariable<float> CVarPlanningBudgetMs(
+		TEXT("paa.AI.PlanningBudgetMs"),
+		250.f,
+		TEXT("Wall time, in milliseconds, the AI may spend searching its turn."));
+
+	TAutoConsoleVariable<int32> CVarPlanningIterations(
+		TEXT("paa.AI.PlanningIterations"),
+		0,
+		TEXT("If positive, every search tree of the AI runs exactly this many iterations and the time budget is ignored, ")
+		TEXT("which makes AI turns reproducible (together with a fixed paa.AI.PlanningWorkers)."));
+
+	TAutoConsoleVariable<int32> CVarPlanningWorkers(
+		TEXT("paa.AI.PlanningWorkers"),
+		0,
+		TEXT("Number of parallel search trees of the AI; 0 uses one per task graph worker thread."));
+}
 
 void UGameAIController::Initialize(AStrategyGameMode* NewGameMode)
 {
@@ -29,7 +50,8 @@ void UGameAIController::OnPhaseChanged(EGamePhase NewPhase)
 
 void UGameAIController::OnSwitchTurn(bool bIsPlayerTurn)
 {
-	if (bIsPlayerTurn) return;
+	// Recorded matches play both teams themselves.
+	if (bIsPlayerTurn || GameMode->IsReplaying()) return;
 	
 	FTimerHandle TimerHandle;
 	
@@ -59,21 +81,18 @@ void UGameAIController::HandlePlacementPhase()
 	const int32 X = GridManager->GetGridSizeX();
 	const int32 Y = GridManager->GetGridSizeY();
 	const float S = GridManager->GetTileSize();
+	FMatchRng& Stream = GameMode->GetRandomStream(ERandomStream::AIPlacement);
 
-	const TArray<FString> Occupied = BattleManager->GetOccupied();
-	
 	while (true)
 	{
-		Location = FVector(FMath::RandRange(1, X) * S, FMath::RandRange(1, Y) * S, 0);
-		FString TileName = GridManager->WorldToGrid(Location);
+		Location = FVector(Stream.RandRange(1, X) * S, Stream.RandRange(1, Y) * S, 0);
+		const FGridCoord Coord = GridManager->WorldToGrid(Location);
 
-		//UE_LOG(LogTemp, Display, TEXT("%s"), *TileName)
+		//UE_LOG(LogTemp, Display, TEXT("%s"), *GridManager->GetTileName(Coord))
 		
-		const ATile* Tile = GridManager->GetTile(TileName).Get();
-
-		if (!Tile) UE_LOG(LogTemp, Error, TEXT("NO TILE WITH SUCH LOCATION"));
+		if (!Coord.IsSet()) UE_LOG(LogTemp, Error, TEXT("NO TILE WITH SUCH LOCATION"));
 		
-		if (Tile && !Tile->IsObstacle() && !Occupied.Contains(GridManager->WorldToGrid(Location))) break;
+		if (Coord.IsSet() && !GridManager->IsObstacle(Coord) && !BattleManager->IsOccupied(Coord)) break;
 	}
 
 	//UE_LOG(LogTemp, Display, TEXT("%s"), *Location.ToString());
@@ -84,15 +103,53 @@ void UGameAIController::HandlePlacementPhase()
 
 void UGameAIController::HandleBattlePhase()
 {
-	UBattleManager* BattleManager = GameMode->GetBattleManager();
-	
-	// Retrieve AI and Player units
+	const UBattleManager* BattleManager = GameMode->GetBattleManager();
+
+	if (!BattleManager)
+	{
+		OnPlanReady(FAITurnPlan());
+		return;
+	}
+
+	FAIPlannerSettings Settings;
+	Settings.BudgetSeconds = FMath::Max(1.f, CVarPlanningBudgetMs.GetValueOnGameThread()) / 1000.0;
+	Settings.NumWorkers = CVarPlanningWorkers.GetValueOnGameThread() > 0
+		? CVarPlanningWorkers.GetValueOnGameThread()
+		: FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	Settings.IterationsPerWorker = CVarPlanningIterations.GetValueOnGameThread();
 
+	FMatchRng& Stream = GameMode->GetRandomStream(ERandomStream::AISearch);
+	Settings.Seed = Stream.Next();
 
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> PlayerUnitsMap = BattleManager->GetPlayerUnits();
-	TArray<TWeakObjectPtr<ABaseUnit>> PlayerUnits;
-	PlayerUnitsMap.GetKeys(PlayerUnits);
+	// The planner only reads its copy of the state, so the game thread is free while the turn is searched.
+	FBattleState Snapshot = FAITurnPlanner::Capture(*BattleManager, Stream.Next(), PlannedUnits);
+	FInfluenceMap Influence = BattleManager->GetInfluenceMap();
+	TWeakObjectPtr<UGameAIController> WeakThis(this);
 
+	Async(EAsyncExecution::TaskGraph, [WeakThis, Snapshot = MoveTemp(Snapshot), Influence = MoveTemp(Influence), Settings]()
+	{
+		FAITurnPlan Plan = FAITurnPlanner::Plan(Snapshot, Influence, Settings);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Plan = MoveTemp(Plan)]() mutable
+		{
+			if (UGameAIController* Controller = WeakThis.Get())
+			{
+				Controller->OnPlanReady(MoveTemp(Plan));
+			}
+		});
+	});
+}
+
+void UGameAIController::OnPlanReady(FAITurnPlan&& Plan)
+{
+	// The battle may have ended while the plan was computed.
+	if (CurrentPhase != EGamePhase::Battle) return;
+
+	UE_LOG(LogTemp, Display, TEXT("AI turn planned in %.1f ms: %lld iterations, %lld nodes (%.0f nodes/s), %d actions"),
+		Plan.PlanningSeconds * 1000.0, Plan.Iterations, Plan.Nodes,
+		Plan.Nodes / FMath::Max(Plan.PlanningSeconds, UE_DOUBLE_SMALL_NUMBER), Plan.Actions.Num());
+
+	CurrentPlan = MoveTemp(Plan);
 	BattleState = EBattleState::Movement;
 	CurrentUnitIndex = 0;
 	
@@ -120,143 +177,121 @@ void UGameAIController::ProcessNextAction()
 
 void UGameAIController::ProcessMovement(UBattleManager* BattleManager, AGridManager* GridManager)
 {
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> AIUnitsMap = BattleManager->GetAIUnits();
-	TArray<TWeakObjectPtr<ABaseUnit>> AIUnits;
-	AIUnitsMap.GetKeys(AIUnits);
-	
-	if (CurrentUnitIndex >= AIUnits.Num())
+	if (CurrentUnitIndex >= CurrentPlan.Actions.Num())
 	{
-		// All units processed for movement, transition to Attack state
-		BattleState = EBattleState::Attack;
+		// Every planned action was played, transition to Idle
+		BattleState = EBattleState::Idle;
 		CurrentUnitIndex = 0;
 		ProcessNextAction();
 		return;
 	}
 
-	ABaseUnit* AIUnit = AIUnits[CurrentUnitIndex].Get();
-	if (AIUnit)
+	// The plan interleaves units: this unit attacks right after its move, before the next unit moves
+	const FPlannedAction& Action = CurrentPlan.Actions[CurrentUnitIndex];
+	ABaseUnit* AIUnit = GetPlannedUnit(Action.UnitIndex);
+	BattleState = EBattleState::Attack;
+
+	// Units that died since the plan was captured, or that stay put, go straight to their attack
+	if (!AIUnit || !Action.MoveTo.IsSet())
 	{
-		CurrentUnitIndex++;
-		TryMove(BattleManager, GridManager, AIUnit);
+		ProcessNextAction();
+		return;
 	}
+
+	TryMove(BattleManager, GridManager, AIUnit, Action.MoveTo);
 }
 
-void UGameAIController::TryMove(const UBattleManager* BattleManager, const AGridManager* GridManager, ABaseUnit* AIUnit)
+void UGameAIController::TryMove(const UBattleManager* BattleManager, const AGridManager* GridManager, ABaseUnit* AIUnit, const FGridCoord& MoveTo)
 {
 	if (!BattleManager || !GridManager) 
 	{
 		ProcessNextAction();
 		return;
 	}
-	
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> PlayerUnitsMap = BattleManager->GetPlayerUnits();
-	TArray<TWeakObjectPtr<ABaseUnit>> PlayerUnits;
-	PlayerUnitsMap.GetKeys(PlayerUnits);
-	
-	const TArray<FString> MovementTiles = GridManager->FindArea(AIUnit->GetPosition(), AIUnit->GetMovementRange(), true, BattleManager->GetOccupied());
-	const ABaseUnit* NearestPlayerUnit = FindNearestPlayerUnit(AIUnit, PlayerUnits, GridManager);
-	const FString BestMovementTile = FindBestMovementTile(AIUnit, MovementTiles, NearestPlayerUnit, GameMode.Get());
 
-	// If no valid movement tile is found, proceed to the next action
-	if (BestMovementTile.IsEmpty())
+	// The plan resolved conflicts between AI units, but the tile may have been taken since the snapshot
+	if (!GridManager->GetGridData().IsInside(MoveTo) || BattleManager->IsOccupied(MoveTo) || MoveTo == AIUnit->GetPosition())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("No valid movement tile found for AI unit. Skipping move."));
+		UE_LOG(LogTemp, Warning, TEXT("Planned movement tile is no longer valid for AI unit. Skipping move."));
 		ProcessNextAction();
 		return;
 	}
-	
-	if (ATile* Tile = GridManager->GetTile(BestMovementTile).Get())
-	{
-		if (BestMovementTile != AIUnit->GetPosition())
+
+	// Broadcast the first event immediately
+	GameMode->GetPlayerController()->OnUnitClicked.Broadcast(AIUnit, true);
+
+	// Set a timer to broadcast the second event after 0.4 seconds
+	FTimerHandle TileClickTimerHandle;
+	GetWorld()->GetTimerManager().SetTimer(
+		TileClickTimerHandle,
+		[this, MoveTo]()
 		{
-			// Broadcast the first event immediately
-			GameMode->GetPlayerController()->OnUnitClicked.Broadcast(AIUnit, true);
+			GameMode->GetPlayerController()->OnTileClicked.Broadcast(MoveTo, true);
 
-			// Set a timer to broadcast the second event after 0.4 seconds
-			FTimerHandle TileClickTimerHandle;
+			// Set a timer to process the next action after 0.2 seconds
+			FTimerHandle NextActionTimerHandle;
 			GetWorld()->GetTimerManager().SetTimer(
-				TileClickTimerHandle,
-				[this, Tile]()
-				{
-					GameMode->GetPlayerController()->OnTileClicked.Broadcast(Tile, true);
-
-					// Set a timer to process the next action after 0.2 seconds
-					FTimerHandle NextActionTimerHandle;
-					GetWorld()->GetTimerManager().SetTimer(
-						NextActionTimerHandle,
-						this,
-						&UGameAIController::ProcessNextAction,
-						0.2f,
-						false
-					);
-				},
-				0.4f,
+				NextActionTimerHandle,
+				this,
+				&UGameAIController::ProcessNextAction,
+				0.2f,
 				false
 			);
-		}
-		else
-		{
-			// If the best tile is the current tile, skip moving and proceed to the next action
-			ProcessNextAction();
-		}
-	}
-	else
-	{
-		// If the tile is invalid, proceed to the next action
-		ProcessNextAction();
-	}
+		},
+		0.4f,
+		false
+	);
 }
 
 void UGameAIController::ProcessAttack(UBattleManager* BattleManager, AGridManager* GridManager)
 {
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> AIUnitsMap = BattleManager->GetAIUnits();
-	TArray<TWeakObjectPtr<ABaseUnit>> AIUnits;
-	AIUnitsMap.GetKeys(AIUnits);
-	
-	if (CurrentUnitIndex >= AIUnits.Num())
+	const FPlannedAction& Action = CurrentPlan.Actions[CurrentUnitIndex++];
+	ABaseUnit* AIUnit = GetPlannedUnit(Action.UnitIndex);
+	BattleState = EBattleState::Movement;
+
+	// The search may decide not to attack (e.g. a sniper avoiding a counter-attack)
+	if (!AIUnit || Action.TargetIndex == INDEX_NONE)
 	{
-		// All attacks processed, transition to Idle
-		BattleState = EBattleState::Idle;
-		CurrentUnitIndex = 0;
 		ProcessNextAction();
 		return;
 	}
 
-	ABaseUnit* AIUnit = AIUnits[CurrentUnitIndex].Get();
-	if (AIUnit)
-	{
-		CurrentUnitIndex++;
-		TryAttack(BattleManager, GridManager, AIUnit);
-	}
+	TryAttack(BattleManager, AIUnit, Action);
 }
 
-void UGameAIController::TryAttack(const UBattleManager* BattleManager, const AGridManager* GridManager, ABaseUnit* AIUnit)
+void UGameAIController::TryAttack(const UBattleManager* BattleManager, ABaseUnit* AIUnit, const FPlannedAction& Action)
 {
-	if (!BattleManager || !GridManager) 
+	if (!BattleManager) 
 	{
 		ProcessNextAction();
 		return;
 	}
 
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> PlayerUnitsMap = BattleManager->GetPlayerUnits();
-	TArray<TWeakObjectPtr<ABaseUnit>> PlayerUnits;
-	PlayerUnitsMap.GetKeys(PlayerUnits);
-	
-	const TArray<FString> AttackTiles = GridManager->FindArea(AIUnit->GetPosition(), AIUnit->GetAttackRange(), false, BattleManager->GetOccupied());
-	TArray<ABaseUnit*> Targets;
-	
-	for (TWeakObjectPtr PlayerUnitPtr : PlayerUnits)
+	// The attack range is Manhattan distance, and obstacles between the two tiles block the shot.
+	const FBattleState& State = BattleManager->GetBattleState();
+	const auto IsInRange = [AIUnit, &State](const ABaseUnit* PlayerUnit)
 	{
-		ABaseUnit* PlayerUnit = PlayerUnitPtr.Get();
-		
-		if (PlayerUnit && AttackTiles.Contains(PlayerUnit->GetPosition()))
+		return PlayerUnit && AIUnit->GetPosition().Distance(PlayerUnit->GetPosition()) <= AIUnit->GetAttackRange() &&
+			State.HasLineOfSight(AIUnit->GetPosition(), PlayerUnit->GetPosition());
+	};
+
+	// Prefer the planned target; if it died or a move was skipped, take the first player unit still in range
+	ABaseUnit* Target = GetPlannedUnit(Action.TargetIndex);
+	if (!IsInRange(Target))
+	{
+		Target = nullptr;
+		for (const FUnitEntry& Entry : BattleManager->GetPlayerUnits())
 		{
-			Targets.Add(PlayerUnit);
+			if (IsInRange(Entry.Unit.Get()))
+			{
+				Target = Entry.Unit.Get();
+				break;
+			}
 		}
 	}
 
 	// If no valid target is found, proceed to the next action
-	if (Targets.Num() == 0)
+	if (!Target)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("No valid attack target found for AI unit. Skipping attack."));
 		ProcessNextAction();
@@ -267,13 +302,16 @@ void UGameAIController::TryAttack(const UBattleManager* BattleManager, const AGr
 	GameMode->GetPlayerController()->OnUnitClicked.Broadcast(AIUnit, false);
 
 	// Set a timer to broadcast the second event after 0.4 seconds
+	TWeakObjectPtr<ABaseUnit> WeakTarget(Target);
 	FTimerHandle AttackTimerHandle;
 	GetWorld()->GetTimerManager().SetTimer(
 		AttackTimerHandle,
-		[this, Targets]()
+		[this, WeakTarget]()
 		{
-			ABaseUnit* Target = Targets[0];
-			GameMode->GetPlayerController()->OnUnitClicked.Broadcast(Target, false);
+			if (ABaseUnit* Target = WeakTarget.Get())
+			{
+				GameMode->GetPlayerController()->OnUnitClicked.Broadcast(Target, false);
+			}
 
 			// Set a timer to process the next action after 0.2 seconds
 			FTimerHandle NextActionTimerHandle;
@@ -290,63 +328,7 @@ void UGameAIController::TryAttack(const UBattleManager* BattleManager, const AGr
 	);
 }
 
-ABaseUnit* UGameAIController::FindNearestPlayerUnit(const ABaseUnit* AIUnit, const TArray<TWeakObjectPtr<ABaseUnit>>& PlayerUnits, const AGridManager* GridManager)
+ABaseUnit* UGameAIController::GetPlannedUnit(const int32 Index) const
 {
-	if (!AIUnit || !GridManager) return nullptr;
-
-	const FVector AIWorldPos = GridManager->GridToWorld(AIUnit->GetPosition());
-	
-	float MinDistance = FLT_MAX;
-	ABaseUnit* NearestPlayer = nullptr;
-
-	for (TWeakObjectPtr PlayerUnitPtr : PlayerUnits)
-	{
-		ABaseUnit* PlayerUnit = PlayerUnitPtr.Get();
-		
-		if (PlayerUnit)
-		{
-			float Distance = FVector::Distance(AIWorldPos, GridManager->GridToWorld(PlayerUnit->GetPosition()));
-
-			if (Distance < MinDistance)
-			{
-				MinDistance = Distance;
-				NearestPlayer = PlayerUnit;
-			}
-		}
-	}
-
-	return NearestPlayer;
-}
-
-FString UGameAIController::FindBestMovementTile(const ABaseUnit* AIUnit, const TArray<FString>& MovementTiles, const ABaseUnit* TargetPlayer, AStrategyGameMode* GameMode)
-{
-	if (!TargetPlayer || !GameMode || !GameMode->GetGridManager()) return FString();
-
-	// Get the grid manager and the positions of the AI unit and the target player
-	AGridManager* GridManager = GameMode->GetGridManager();
-	FString StartTile = AIUnit->GetPosition();
-	FString TargetTile = TargetPlayer->GetPosition();
-
-	// Get the list of occupied tiles (obstacles)
-	TArray<FString> OccupiedTiles = GameMode->GetBattleManager()->GetOccupied();
-	OccupiedTiles.Remove(TargetTile);
-	OccupiedTiles.Remove(StartTile);
-	
-	// Use A* to find the path from the AI unit to the target player
-	TArray<FString> Path = GridManager->FindPath(StartTile, TargetTile, OccupiedTiles);
-
-	// Find the latest tile in the path that is within the AI unit's movement range AND not occupied
-	for (int32 i = Path.Num() - 1; i >= 0; --i)
-	{
-		const FString& Tile = Path[i];
-
-		// Check if the tile is in the movement range and not occupied
-		if (MovementTiles.Contains(Tile) && !OccupiedTiles.Contains(Tile))
-		{
-			return Tile; // Return the best tile
-		}
-	}
-
-	// If no valid tile is found, return an empty string
-	return FString();
+	return PlannedUnits.IsValidIndex(Index) ? PlannedUnits[Index].Get() : nullptr;
 }
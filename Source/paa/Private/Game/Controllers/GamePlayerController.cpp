@@ -121,10 +121,10 @@ void AGamePlayerController::SetupInputComponent()
 	UE_LOG(LogTemp, Log, TEXT("SetupInputComponent Completed"));
 }
 
-void AGamePlayerController::PlacementClick(const ATile* Tile) const
+void AGamePlayerController::PlacementClick(const FGridCoord& Tile) const
 {
 	// Broadcast the placement click event with the tile's location.
-	OnPlacementClick.Broadcast(Tile->GetActorLocation());
+	OnPlacementClick.Broadcast(GameMode->GetGridManager()->GridToWorld(Tile));
 }
 
 void AGamePlayerController::UnitClicked(ABaseUnit* Unit, const bool bIsLeftClick) const
@@ -133,77 +133,71 @@ void AGamePlayerController::UnitClicked(ABaseUnit* Unit, const bool bIsLeftClick
 	OnUnitClicked.Broadcast(Unit, bIsLeftClick);
 }
 
-void AGamePlayerController::TileClicked(ATile* Tile, const bool bIsLeftClick) const
+void AGamePlayerController::TileClicked(const FGridCoord& Tile, const bool bIsLeftClick) const
 {
 	// Broadcast the tile click event.
 	OnTileClicked.Broadcast(Tile, bIsLeftClick);
 }
 
-void AGamePlayerController::OnLeftMouseClicked()
+void AGamePlayerController::PlayerTick(float DeltaTime)
 {
-	if (!bEnableInput) return; // Ignore input if it is disabled.
-
-	//UE_LOG(LogTemp, Log, TEXT("Left Mouse Clicked"));
-
-	FHitResult Hit;
-	GetHitResultUnderCursor(ECC_Visibility, false, Hit); // Get the object under the cursor.
+	Super::PlayerTick(DeltaTime);
 
-	if (!Hit.bBlockingHit)
-	{
-		UE_LOG(LogTemp, Log, TEXT("Hit Nothing"));
-		return;
-	}
+	// Picking is a ray-plane intersection, so following the cursor every frame costs nothing.
+	const FGridCoord Tile = bEnableInput && GameMode.IsValid() ? PickTileUnderCursor() : FGridCoord();
+	if (Tile == HoveredTile) return;
 
-	// Process tile clicks.
-	if (ATile* HitTile = Cast<ATile>(Hit.GetActor()))
-	{
-		ProcessTileClick(HitTile, true);
-		return;
-	}
+	HoveredTile = Tile;
+	OnTileHovered.Broadcast(HoveredTile); // Broadcast the newly hovered tile.
+}
 
-	// Process unit clicks.
-	if (ABaseUnit* HitUnit = Cast<ABaseUnit>(Hit.GetActor()))
-	{
-		ProcessUnitClick(HitUnit, true);
-		return;
-	}
+FGridCoord AGamePlayerController::GetHoveredTile() const
+{
+	return HoveredTile;
+}
 
-	UE_LOG(LogTemp, Display, TEXT("Clicked object is not recognized"));
+void AGamePlayerController::OnLeftMouseClicked()
+{
+	ProcessClick(true);
 }
 
 void AGamePlayerController::OnRightMouseClicked()
+{
+	ProcessClick(false);
+}
+
+void AGamePlayerController::ProcessClick(bool bIsLeftClick)
 {
 	if (!bEnableInput) return; // Ignore input if it is disabled.
 
-	//UE_LOG(LogTemp, Log, TEXT("Right Mouse Clicked"));
-	
-	FHitResult Hit;
-	GetHitResultUnderCursor(ECC_Visibility, false, Hit); // Get the object under the cursor.
+	const FGridCoord Tile = PickTileUnderCursor(); // Get the tile under the cursor.
 
-	if (!Hit.bBlockingHit)
+	if (!Tile.IsSet())
 	{
 		UE_LOG(LogTemp, Log, TEXT("Hit Nothing"));
 		return;
 	}
 
-	// Process tile clicks.
-	if (ATile* HitTile = Cast<ATile>(Hit.GetActor()))
+	// Units stand on top of their tile, so a click on an occupied tile is a click on its unit.
+	if (ABaseUnit* Unit = GameMode->GetBattleManager()->GetUnitAt(Tile))
 	{
-		ProcessTileClick(HitTile, false);
+		ProcessUnitClick(Unit, bIsLeftClick);
 		return;
 	}
 
-	// Process unit clicks.
-	if (ABaseUnit* HitUnit = Cast<ABaseUnit>(Hit.GetActor()))
-	{
-		ProcessUnitClick(HitUnit, false);
-		return;
-	}
+	ProcessTileClick(Tile, bIsLeftClick);
+}
+
+FGridCoord AGamePlayerController::PickTileUnderCursor() const
+{
+	FVector RayOrigin;
+	FVector RayDirection;
+	if (!DeprojectMousePositionToWorld(RayOrigin, RayDirection)) return FGridCoord();
 
-	UE_LOG(LogTemp, Display, TEXT("Clicked object is not recognized"));
+	return GameMode->GetGridManager()->PickTile(RayOrigin, RayDirection);
 }
 
-void AGamePlayerController::ProcessTileClick(ATile* Tile, bool bIsLeftClick)
+void AGamePlayerController::ProcessTileClick(const FGridCoord& Tile, bool bIsLeftClick)
 {
 	// Handle tile clicks based on the current game phase.
 	switch (CurrentPhase)
@@ -246,7 +240,7 @@ void AGamePlayerController::OnPhaseChanged(EGamePhase NewPhase)
 
 void AGamePlayerController::OnSwitchTurn(bool bIsPlayerTurn)
 {
-	bEnableInput = bIsPlayerTurn; // Enable or disable input based on whose turn it is.
+	bEnableInput = bIsPlayerTurn && !GameMode->IsReplaying(); // Enable or disable input based on whose turn it is (recorded matches play themselves).
 
 	UE_LOG(LogTemp, Display, TEXT("Enable Input : %u"), bIsPlayerTurn);
 }
\ No newline at end of file
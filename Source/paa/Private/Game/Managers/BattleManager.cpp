@@ -1,8 +1,19 @@
 #include "Game/Managers/BattleManager.h"
 
 #include "Game/Controllers/GamePlayerController.h"
+#include "HAL/IConsoleManager.h"
 #include "Systems/DamageSystem.h"
 #include "Systems/MovementSystem.h"
+#include "Units/SniperUnit.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarShowInfluence(
+		TEXT("paa.AI.ShowInfluence"),
+		0,
+		TEXT("Tints the tiles with a layer of the AI's influence map, redrawn after every action: ")
+		TEXT("0 off, 1 threat of the player's units, 2 support of the AI's units, 3 distance to the nearest player unit."));
+}
 
 void UBattleManager::Initialize(AStrategyGameMode* GameModeRef)
 {
@@ -16,6 +27,7 @@ void UBattleManager::Initialize(AStrategyGameMode* GameModeRef)
 
     	GameMode->GetPlayerController()->OnUnitClicked.RemoveDynamic(this, &UBattleManager::UnitSelected);
     	GameMode->GetPlayerController()->OnTileClicked.RemoveDynamic(this, &UBattleManager::TileSelected);
+    	GameMode->GetPlayerController()->OnTileHovered.RemoveDynamic(this, &UBattleManager::TileHovered);
 
     	// Bind game events.
         GameMode->OnGamePhaseChanged.AddDynamic(this, &UBattleManager::OnGamePhaseChanged);
@@ -24,6 +36,7 @@ void UBattleManager::Initialize(AStrategyGameMode* GameModeRef)
         // Bind input events.
         GameMode->GetPlayerController()->OnUnitClicked.AddDynamic(this, &UBattleManager::UnitSelected);
         GameMode->GetPlayerController()->OnTileClicked.AddDynamic(this, &UBattleManager::TileSelected);
+        GameMode->GetPlayerController()->OnTileHovered.AddDynamic(this, &UBattleManager::TileHovered);
     }
     else
     {
@@ -33,13 +46,7 @@ void UBattleManager::Initialize(AStrategyGameMode* GameModeRef)
 
 void UBattleManager::OnTurnSkipped()
 {
-	auto& CurrentUnits = bIsPlayerTurn ? PlayerUnits : AIUnits;
-
-	// Reset actions for all units in the current turn.
-	for (auto& Tuple : CurrentUnits)
-	{
-		Tuple.Value = EActionType::None;
-	}
+	FBattleRules::EndTurn(State); // Reset actions for all units in the current turn.
 
 	OnCanSkipTurn.Broadcast(false); // Notify that the turn cannot be skipped anymore.
 
@@ -51,50 +58,83 @@ void UBattleManager::OnTurnSkipped()
 void UBattleManager::OnGamePhaseChanged(EGamePhase NewPhase)
 {
     CurrentGamePhase = NewPhase; // Update the current game phase.
+
+	// Units are placed on the grid generated for this game, and the match is recorded from here on.
+	if (CurrentGamePhase == EGamePhase::Placement)
+	{
+		ResetOccupancy();
+		Replay.Start(GameMode->GetMatchSeed(), State.Grid);
+	}
+
+	// Obstacles are generated while units are placed, so the battle state takes them when the battle starts.
+	if (CurrentGamePhase == EGamePhase::Battle)
+	{
+		State.SetTerrain(GameMode->GetGridManager()->GetGridData());
+		MoveTree.Reset(); // Built against the placement-time obstacles.
+		State.Random = GameMode->GetRandomStream(ERandomStream::Damage);
+		Replay.SetTerrain(State.Grid);
+		RebuildInfluence();
+	}
 }
 
 void UBattleManager::OnSwitchTurn(const bool NewBIsPlayerTurn)
 {
     bIsPlayerTurn = NewBIsPlayerTurn; // Update the turn state.
+	State.bPlayerTurn = NewBIsPlayerTurn;
+
+	// Build the distance fields of every unit so the turn only performs lookups.
+	if (CurrentGamePhase == EGamePhase::Battle)
+	{
+		Replay.RecordTurn(NewBIsPlayerTurn);
+		GameMode->GetGridManager()->WarmDistanceFields(State.Occupied);
+		RebuildInfluence(); // Threat stamps follow the occupancy, which the last turn changed.
+	}
 }
 
 void UBattleManager::ResetUnits()
 {
 	// Destroy all player units.
-	for (auto Unit : PlayerUnits)
+	for (const FUnitEntry& Entry : PlayerUnits)
 	{
-		Unit.Key->Destroy();
+		if (Entry.Unit.IsValid()) Entry.Unit->Destroy();
 	}
 
 	// Destroy all AI units.
-	for (auto AIUnit : AIUnits)
+	for (const FUnitEntry& Entry : AIUnits)
 	{
-		AIUnit.Key->Destroy();
+		if (Entry.Unit.IsValid()) Entry.Unit->Destroy();
 	}
 	
 	PlayerUnits.Empty(); // Clear the player units list.
 	AIUnits.Empty(); // Clear the AI units list.
+	ResetOccupancy(); // Clear the occupancy index.
 }
 
 void UBattleManager::AddPlayerUnit(ABaseUnit* Unit)
 {
-    PlayerUnits.Add(Unit, EActionType::None); // Add the unit to the player's list with no action.
+    PlayerUnits.Add({ Unit, AddToState(Unit, true) }); // Add the unit to the player's list and to the battle state.
 }
 
 void UBattleManager::AddAIUnit(ABaseUnit* Unit)
 {
-    AIUnits.Add(Unit, EActionType::None); // Add the unit to the AI's list with no action.
+    AIUnits.Add({ Unit, AddToState(Unit, false) }); // Add the unit to the AI's list and to the battle state.
 }
 
-TArray<FString> UBattleManager::GetOccupied() const
+const TBitArray<>& UBattleManager::GetOccupiedMask() const
 {
-    TArray<FString> OccupiedTiles;
-	
-    // Combine positions from all player and AI units.
-    for (const auto& Tuple : PlayerUnits) OccupiedTiles.Add(Tuple.Key->GetPosition());
-    for (const auto& Tuple : AIUnits) OccupiedTiles.Add(Tuple.Key->GetPosition());
-    
-    return OccupiedTiles; // Return the list of occupied tiles.
+	return State.Occupied; // Return the occupancy bitset of the battle state.
+}
+
+bool UBattleManager::IsOccupied(const FGridCoord& Tile) const
+{
+	const int32 Index = GameMode->GetGridManager()->GetGridData().ToIndex(Tile);
+	return Index != INDEX_NONE && State.Occupied.IsValidIndex(Index) && State.Occupied[Index];
+}
+
+ABaseUnit* UBattleManager::GetUnitAt(const FGridCoord& Tile) const
+{
+	const int32 Index = GameMode->GetGridManager()->GetGridData().ToIndex(Tile);
+	return Index != INDEX_NONE && Occupants.IsValidIndex(Index) ? Occupants[Index].Get() : nullptr;
 }
 
 void UBattleManager::UnitSelected(ABaseUnit* Unit, bool bIsLeftClick)
@@ -105,10 +145,6 @@ void UBattleManager::UnitSelected(ABaseUnit* Unit, bool bIsLeftClick)
     // Selection Logic
     if (ShouldSelectNewUnit(Unit, ReceivedClick))
     {
-    	// Clear previous highlights.
-    	GridManager->ColorTiles(ColoredTiles, FLinearColor::White);
-    	ColoredTiles.Empty();
-    	
         HandleNewSelection(Unit, bIsLeftClick, ReceivedClick, GridManager); // Handle the new selection.
     }
     else if (IsDeselectionScenario(Unit))
@@ -122,53 +158,59 @@ void UBattleManager::UnitSelected(ABaseUnit* Unit, bool bIsLeftClick)
     }
 }
 
-void UBattleManager::TileSelected(ATile* Tile, bool bIsLeftClick)
+void UBattleManager::TileSelected(const FGridCoord& GridPosition, bool bIsLeftClick)
 {
-	if (!Tile) return;
+	if (!GridPosition.IsSet()) return;
 	
-	const FString GridPosition = GameMode->GetGridManager()->WorldToGrid(Tile->GetActorLocation());
+	const AGridManager* GridManager = GameMode->GetGridManager();
 
 	// Validate the selection.
-	if (!SelectedUnit.Get() || bIsPlayerTurn != PlayerUnits.Contains(SelectedUnit) ||
-		!bIsLeftClick || ClickType != EClickType::Left || !ColoredTiles.Contains(GridPosition)) return;
+	if (!SelectedUnit.Get() || bIsPlayerTurn != IsPlayerUnit(SelectedUnit.Get()) ||
+		!bIsLeftClick || ClickType != EClickType::Left) return;
 
-	if (PlayerUnits.Contains(SelectedUnit))
-	{
-		if (PlayerUnits[SelectedUnit] != EActionType::None)
-			return;
-	}
-	else
-	{
-		if (AIUnits[SelectedUnit] != EActionType::None)
-			return;
-	}
+	// The tile must be within the highlighted movement range (a lookup in the unit's cached distance field).
+	const int32 Distance = GridManager->GetPathDistance(SelectedUnit->GetPosition(), GridPosition, State.Occupied);
+	if (Distance == INDEX_NONE || Distance > SelectedUnit->GetMovementRange()) return;
+
+	// Units that already acted this turn cannot move.
+	if (const FUnitEntry* Entry = FindEntry(SelectedUnit.Get()); !Entry || !FBattleRules::CanAct(State, Entry->Index)) return;
 	
     MoveUnit(GridPosition); // Move the selected unit to the tile.
 
     ClearSelection(GameMode->GetGridManager()); // Clear the selection after moving.
 }
 
-void UBattleManager::AttackUnit(ABaseUnit* Unit)
+void UBattleManager::TileHovered(const FGridCoord& Tile)
 {
-    const FString StartingTile = SelectedUnit->GetPosition();
-    const TPair<int32, int32> DamageValues = UDamageSystem::ApplyDamage(SelectedUnit, Unit);
-	
-    FormatAction(DamageValues.Key, StartingTile, "", Unit, DamageValues.Value); // Format and broadcast the attack action.
+	if (CurrentGamePhase != EGamePhase::Battle) return;
 
-	auto& CurrentUnits = bIsPlayerTurn ? PlayerUnits : AIUnits;
+	AGridManager* GridManager = GameMode->GetGridManager();
+	const FGridData& Grid = GridManager->GetGridData();
+
+	// Only a player unit selected to move, that has not acted yet, previews its path.
+	const FUnitEntry* Entry = FindEntry(SelectedUnit.Get());
+	const bool bCanPreview = Entry && ClickType == EClickType::Left && bIsPlayerTurn && IsPlayerUnit(SelectedUnit.Get()) &&
+		FBattleRules::CanAct(State, Entry->Index) && MoveTree.IsBuiltFrom(Grid.ToIndex(SelectedUnit->GetPosition()), SelectedUnit->GetMovementRange());
+
+	// One parent walk in the selection's search tree; tiles out of range or cut off have no path.
+	if (!bCanPreview || !MoveTree.GetPath(Grid, Grid.ToIndex(Tile), PreviewPath) || PreviewPath.Num() < 2) PreviewPath.Reset();
+
+	GridManager->SetPathPreview(PreviewPath, FLinearColor::Yellow);
+}
+
+void UBattleManager::AttackUnit(ABaseUnit* Unit)
+{
+	// The rules roll the damage on the battle state (and update the attacker's action); the actors then take it.
+	FBattleUndo Undo;
+	const int32 Attacker = FindEntry(SelectedUnit.Get())->Index;
+	const int32 Target = FindEntry(Unit)->Index;
+	const FBattleAttackResult Result = FBattleRules::ApplyAttack(State, Attacker, Target, Undo);
+	UDamageSystem::ApplyDamage(SelectedUnit, Unit, Result);
+	Replay.RecordAttack(Attacker, Target, Result);
+	UpdateInfluence(Attacker); // Either side may have died.
+	UpdateInfluence(Target);
 	
-	// Update the unit's action type.
-	switch (CurrentUnits[SelectedUnit])
-	{
-	case EActionType::None:
-		CurrentUnits[SelectedUnit] = EActionType::Attack;
-		break;
-	case EActionType::Move:
-		CurrentUnits[SelectedUnit] = EActionType::MoveAndAttack;
-		break;
-	default:
-		break;
-	}
+	OnBattleAction.Broadcast(FBattleActionRecord::MakeAttack(State, Attacker, Target, Result)); // Broadcast the attack action.
 
 	HandleUnitDeath(SelectedUnit.Get(), Unit); // Handle unit death if applicable.
 
@@ -176,25 +218,39 @@ void UBattleManager::AttackUnit(ABaseUnit* Unit)
 	CheckEndConditions(); // Check if the game has ended.
 }
 
-void UBattleManager::MoveUnit(const FString& GridPosition)
+void UBattleManager::MoveUnit(const FGridCoord& GridPosition)
 {
-	const FString OriginalPosition = SelectedUnit->GetPosition();
+	const FGridCoord OriginalPosition = SelectedUnit->GetPosition();
 	
-	UMovementSystem::ApplyMovement(SelectedUnit, GridPosition, GetOccupied()); // Move the unit.
-	FormatAction(-1, OriginalPosition, GridPosition, nullptr, -1); // Format and broadcast the move action.
+	// The unit walks the path previewed to the player when the selection's search tree reaches the tile.
+	const AGridManager* GridManager = GameMode->GetGridManager();
+	const FGridData& Grid = GridManager->GetGridData();
+	TArray<FGridCoord> Path;
+	if (MoveTree.IsBuiltFrom(Grid.ToIndex(OriginalPosition), SelectedUnit->GetMovementRange()) && MoveTree.GetPath(Grid, Grid.ToIndex(GridPosition), Path))
+	{
+		UMovementSystem::ApplyMovement(SelectedUnit, MoveTemp(Path), GridManager); // Move the unit.
+	}
+	else
+	{
+		UMovementSystem::ApplyMovement(SelectedUnit, GridPosition, State.Occupied, GridManager); // Move the unit.
+	}
 
-	auto& CurrentUnits = bIsPlayerTurn ? PlayerUnits : AIUnits;
-	
-	// Update the unit's action type.
-	switch (CurrentUnits[SelectedUnit])
+	// Mirror where the unit actually ended up (its own tile if no path was found) and spend its move.
+	const int32 Index = FindEntry(SelectedUnit.Get())->Index;
+	FBattleUndo Undo;
+	FBattleRules::ApplyMove(State, Index, SelectedUnit->GetPosition(), Undo);
+	Replay.RecordMove(Index, SelectedUnit->GetPosition());
+	UpdateInfluence(Index);
+
+	// Move the unit in the occupancy index if it actually set off.
+	if (SelectedUnit->GetPosition() != OriginalPosition)
 	{
-	case EActionType::None:
-		CurrentUnits[SelectedUnit] = EActionType::Move;
-		break;
-	default:
-		break;
+		SetOccupant(OriginalPosition, nullptr);
+		SetOccupant(SelectedUnit->GetPosition(), SelectedUnit.Get());
 	}
 
+	OnBattleAction.Broadcast(FBattleActionRecord::MakeMove(State, Index, OriginalPosition)); // Broadcast the move action.
+
 	CheckCanSkipTurn(); // Check if the player can skip their turn.
 }
 
@@ -203,9 +259,9 @@ void UBattleManager::CheckCanSkipTurn() const
 	auto& CurrentUnits = bIsPlayerTurn ? PlayerUnits : AIUnits;
 
 	// Check if all units have performed an action.
-	for (const auto& Tuple : CurrentUnits)
+	for (const FUnitEntry& Entry : CurrentUnits)
 	{
-		if (Tuple.Value == EActionType::None) return;
+		if (State.Units.Action[Entry.Index] == EActionType::None) return;
 	}
 
 	OnCanSkipTurn.Broadcast(true); // Notify that the turn can be skipped.
@@ -217,52 +273,50 @@ void UBattleManager::CheckEndConditions() const
 	OnCanSkipTurn.Broadcast(true); // Enable End Game button
 }
 
-void UBattleManager::FormatAction(const int32 Damage, const FString& StartingTile, 
-                                 const FString& EndTile, ABaseUnit* Unit, const int32 DamageCounter) const
+TConstArrayView<FUnitEntry> UBattleManager::GetAIUnits() const
 {
-	FString Text = "";
-	
-	if (SelectedUnit.Get())
-	{
-		bIsPlayerTurn ? Text += "HP: " : Text += "AI: ";
-		Cast<ABrawlerUnit>(SelectedUnit) ? Text += "B "	: Text += "S ";
-		
-		if (Damage > 0) Text += Unit->GetPosition() + " " + FString::FromInt(Damage); // Append damage if attacking.
-		else Text += StartingTile + " -> " + EndTile; // Append movement if moving.	
-	}
-	else
-	{
-		Text += "ERROR: SELECTED UNIT ISN'T VALID";
-	}
+	return AIUnits; // Return a view of the AI's units.
+}
 
-	OnActionExecuted.Broadcast(Text); // Broadcast the formatted action.
-	
-	if (Unit && DamageCounter > 0)
-	{
-		Text = "";
+TConstArrayView<FUnitEntry> UBattleManager::GetPlayerUnits() const
+{
+	return PlayerUnits; // Return a view of the player's units.
+}
 
-		bIsPlayerTurn ? Text += "HP: " : Text += "AI: ";
-		Cast<ABrawlerUnit>(SelectedUnit) ? Text += "B "	: Text += "S ";
-		Text += StartingTile + " GOT COUNTERED BY ";
-		Cast<ABrawlerUnit>(Unit) ? Text += "B "	: Text += "S ";
-		Text += Unit->GetPosition() + " ";
-		Text += FString::FromInt(DamageCounter);
+TConstArrayView<FUnitEntry> UBattleManager::GetUnits(const bool bPlayerTeam) const
+{
+	return bPlayerTeam ? PlayerUnits : AIUnits; // Return a view of the requested team.
+}
 
-		OnActionExecuted.Broadcast(Text); // Broadcast the counter-attack action.
-	}
+const FBattleState& UBattleManager::GetBattleState() const
+{
+	return State; // Return the battle state.
+}
+
+const FBattleReplay& UBattleManager::GetReplay() const
+{
+	return Replay; // Return the match recording.
+}
+
+const FInfluenceMap& UBattleManager::GetInfluenceMap() const
+{
+	return Influence; // Return the AI's influence map.
 }
 
-TMap<TWeakObjectPtr<ABaseUnit>, EActionType> UBattleManager::GetAIUnits() const
+ABaseUnit* UBattleManager::GetUnitByIndex(const int32 Index) const
 {
-	return AIUnits; // Return the AI's units.
+	const auto Matches = [Index](const FUnitEntry& Entry) { return Entry.Index == Index; };
+	if (const FUnitEntry* Entry = PlayerUnits.FindByPredicate(Matches)) return Entry->Unit.Get();
+	if (const FUnitEntry* Entry = AIUnits.FindByPredicate(Matches)) return Entry->Unit.Get();
+	return nullptr;
 }
 
-TMap<TWeakObjectPtr<ABaseUnit>, EActionType> UBattleManager::GetPlayerUnits() const
+bool UBattleManager::IsPlayerUnit(const ABaseUnit* Unit) const
 {
-	return PlayerUnits; // Return the player's units.
+	return Unit && PlayerUnits.ContainsByPredicate([Unit](const FUnitEntry& Entry) { return Entry.Unit.Get() == Unit; });
 }
 
-TArray<FString> UBattleManager::GetColored() const
+TArray<FGridCoord> UBattleManager::GetColored() const
 {
 	return ColoredTiles; // Return the currently highlighted tiles.
 }
@@ -277,16 +331,33 @@ void UBattleManager::HandleNewSelection(ABaseUnit* Unit, bool bIsLeftClick,
                                        EClickType Click, TWeakObjectPtr<AGridManager> GridManager)
 {
     SelectedUnit = Unit;
-    OnUnitSelected.Broadcast(SelectedUnit.Get(), PlayerUnits.Contains(SelectedUnit)); // Notify that a unit has been selected.
+    OnUnitSelected.Broadcast(SelectedUnit.Get(), IsPlayerUnit(SelectedUnit.Get())); // Notify that a unit has been selected.
 
     // Determine range and color based on click type.
     const int32 Range = bIsLeftClick ? SelectedUnit->GetMovementRange() : SelectedUnit->GetAttackRange();
     const FLinearColor Color = bIsLeftClick ? FLinearColor::Green : FLinearColor::Red;
     
-    ColoredTiles = GridManager->FindArea(SelectedUnit->GetPosition(), Range, bIsLeftClick, GetOccupied()); // Find and highlight tiles.
-    GridManager->ColorTiles(ColoredTiles, Color); // Color the tiles.
+    // Movement ranges come from the unit's cached distance field; attack ranges keep the tiles in line of sight.
+    ColoredTiles = bIsLeftClick
+    	? TArray<FGridCoord>(GridManager->FindMovementRange(SelectedUnit->GetPosition(), Range, State.Occupied))
+    	: GridManager->FindArea(SelectedUnit->GetPosition(), Range, false, State.Occupied);
+    if (bIsLeftClick)
+    {
+    	// One search per selection (or none when the same unit is selected again); hovering then only walks its parents.
+    	const FGridData& Grid = GridManager->GetGridData();
+    	const int32 Source = Grid.ToIndex(SelectedUnit->GetPosition());
+    	if (!MoveTree.IsBuiltFrom(Source, Range)) UPathfindingUtilities::GetPathTree(Grid, Source, Range, State.Occupied, MoveTree);
+    }
+    else
+    {
+    	const FGridCoord Origin = SelectedUnit->GetPosition();
+    	ColoredTiles.RemoveAll([this, &Origin](const FGridCoord& Tile) { return !State.HasLineOfSight(Origin, Tile); });
+    }
+    GridManager->SetHighlight(ColoredTiles, Color); // Replace the previous highlight; only changed tiles are updated.
     
     ClickType = Click; // Update the click type.
+
+    TileHovered(GameMode->GetPlayerController()->GetHoveredTile()); // Preview the path to the tile already under the cursor.
 }
 
 bool UBattleManager::IsDeselectionScenario(const ABaseUnit* Unit) const
@@ -298,30 +369,19 @@ void UBattleManager::ClearSelection(TWeakObjectPtr<AGridManager> GridManager)
 {
     SelectedUnit = nullptr;
     OnUnitSelected.Broadcast(nullptr, false); // Notify that the selection has been cleared.
-    GridManager->ColorTiles(ColoredTiles, FLinearColor::White); // Reset tile colors.
+    GridManager->ClearHighlight(); // Reset tile colors.
     ColoredTiles.Empty(); // Clear the highlighted tiles.
     ClickType = EClickType::Null; // Reset the click type.
 }
 
 bool UBattleManager::IsAttackScenario(const ABaseUnit* Unit, const EClickType Click) const
 {
-	if (PlayerUnits.Contains(SelectedUnit))
-	{
-		if (PlayerUnits[SelectedUnit] != EActionType::None &&
-			PlayerUnits[SelectedUnit] != EActionType::Move)
-			return false;
-	}
-	else
-	{
-		if (AIUnits[SelectedUnit] != EActionType::None &&
-			AIUnits[SelectedUnit] != EActionType::Move)
-			return false;
-	}
+	// Range, teams, turn and "already attacked" are decided by the rules.
+	const FUnitEntry* Entry = FindEntry(SelectedUnit.Get());
+	const FUnitEntry* TargetEntry = FindEntry(Unit);
 
-	return SelectedUnit.Get() && Unit && ClickType == Click && Click == EClickType::Right &&
-		ColoredTiles.Contains(Unit->GetPosition()) &&
-			PlayerUnits.Contains(Unit) != PlayerUnits.Contains(SelectedUnit) &&
-				bIsPlayerTurn == PlayerUnits.Contains(SelectedUnit); // Determine if an attack should occur.
+	return Entry && TargetEntry && ClickType == Click && Click == EClickType::Right &&
+		FBattleRules::CanAttack(State, Entry->Index, TargetEntry->Index); // Determine if an attack should occur.
 }
 
 void UBattleManager::HandleUnitDeath(ABaseUnit* Attacker, ABaseUnit* Target)
@@ -332,8 +392,111 @@ void UBattleManager::HandleUnitDeath(ABaseUnit* Attacker, ABaseUnit* Target)
     {
         if (Unit && Unit->IsDead())
         {
-            (PlayerUnits.Contains(Unit) ? PlayerUnits : AIUnits).Remove(Unit); // Remove the unit from the list.
+            (IsPlayerUnit(Unit) ? PlayerUnits : AIUnits).RemoveAll([Unit](const FUnitEntry& Entry) { return Entry.Unit.Get() == Unit; }); // Remove the unit from the list, keeping the order.
+            SetOccupant(Unit->GetPosition(), nullptr); // Free its tile in the occupancy index (the battle state already did).
+            GameMode->GetGridManager()->NotifyOccupancyChanged(Unit->GetPosition()); // Its tile is free again.
             Unit->Destroy(); // Destroy the unit.
         }
     }
-}
\ No newline at end of file
+}
+
+FUnitEntry* UBattleManager::FindEntry(const ABaseUnit* Unit)
+{
+	return const_cast<FUnitEntry*>(static_cast<const UBattleManager*>(this)->FindEntry(Unit));
+}
+
+const FUnitEntry* UBattleManager::FindEntry(const ABaseUnit* Unit) const
+{
+	if (!Unit) return nullptr;
+
+	// Teams hold a handful of units, so a linear scan of the compact registry is the cheapest lookup.
+	const auto Matches = [Unit](const FUnitEntry& Entry) { return Entry.Unit.Get() == Unit; };
+	if (const FUnitEntry* Entry = PlayerUnits.FindByPredicate(Matches)) return Entry;
+	return AIUnits.FindByPredicate(Matches);
+}
+
+void UBattleManager::ResetOccupancy()
+{
+	const FGridData& Grid = GameMode->GetGridManager()->GetGridData();
+	
+	State.Reset(Grid);
+	Occupants.Init(nullptr, Grid.Num());
+	Influence = FInfluenceMap(); // Built again once the battle starts.
+	MoveTree.Reset();
+}
+
+void UBattleManager::SetOccupant(const FGridCoord& Tile, ABaseUnit* Unit)
+{
+	const int32 Index = GameMode->GetGridManager()->GetGridData().ToIndex(Tile);
+	if (Index == INDEX_NONE) return;
+
+	Occupants[Index] = Unit;
+	MoveTree.Reset(); // Paths may now go through the freed tile, or no longer through the taken one.
+}
+
+int32 UBattleManager::AddToState(ABaseUnit* Unit, const bool bPlayerTeam)
+{
+	// The grid may have been regenerated since the state was last sized.
+	if (State.Grid.Num() != GameMode->GetGridManager()->GetGridData().Num()) ResetOccupancy();
+
+	FBattleUnitDesc Desc;
+	Desc.Type = Cast<ASniperUnit>(Unit) ? EUnitTypes::Sniper : EUnitTypes::Brawler;
+	Desc.bPlayerTeam = bPlayerTeam;
+	Desc.Position = Unit->GetPosition();
+	Desc.LifePoints = Unit->GetCurrentLifePoint();
+	Desc.MovementRange = Unit->GetMovementRange();
+	Desc.AttackRange = Unit->GetAttackRange();
+	Desc.DamageMin = Unit->GetMinDamage();
+	Desc.DamageMax = Unit->GetMaxDamage();
+
+	SetOccupant(Unit->GetPosition(), Unit); // Index the unit's tile.
+
+	const int32 Index = State.AddUnit(Desc);
+	Replay.RecordPlace(Index, Desc);
+
+	return Index;
+}
+
+void UBattleManager::RebuildInfluence()
+{
+	Influence.Build(State, false);
+	ShowInfluence();
+}
+
+void UBattleManager::UpdateInfluence(const int32 Unit)
+{
+	if (!Influence.IsBuilt()) return;
+
+	Influence.UpdateUnit(State, Unit);
+	ShowInfluence();
+}
+
+void UBattleManager::ShowInfluence() const
+{
+	const int32 Layer = CVarShowInfluence.GetValueOnGameThread();
+	if (Layer < 1 || Layer > 3 || !Influence.IsBuilt())
+	{
+		// Turn the tiles back to white once after the view is switched off.
+		if (bInfluenceShown) GameMode->GetGridManager()->SetHeatmap(TConstArrayView<float>(), FLinearColor::White);
+		bInfluenceShown = false;
+		return;
+	}
+
+	const TConstArrayView<int32> Values = Influence.GetLayer(EInfluenceLayer(Layer - 1));
+
+	int32 MaxValue = 1;
+	for (const int32 Value : Values) MaxValue = FMath::Max(MaxValue, Value);
+
+	// Threat and support get hotter as they grow, distance as it shrinks; unreachable tiles stay white.
+	TArray<float> Weights;
+	Weights.SetNumUninitialized(Values.Num());
+	for (int32 Cell = 0; Cell < Values.Num(); ++Cell)
+	{
+		const float Weight = float(FMath::Max(0, Values[Cell])) / MaxValue;
+		Weights[Cell] = Layer != 3 ? Weight : Values[Cell] == INDEX_NONE ? 0.f : 1.f - Weight;
+	}
+
+	const FLinearColor Colors[] = { FLinearColor::Red, FLinearColor::Blue, FLinearColor::Yellow };
+	GameMode->GetGridManager()->SetHeatmap(Weights, Colors[Layer - 1]);
+	bInfluenceShown = true;
+}
@@ -48,7 +48,7 @@ void UPlacementManager::PlaceUnit(bool bIsPlayer)
 
 		if (SelectedUnitLocation == FVector(-1, -1, -1)) return;
 
-		if (const FString Location = GameMode->GetGridManager()->WorldToGrid(SelectedUnitLocation); GameMode->GetGridManager()->GetTile(Location)->IsObstacle()) return;
+		if (const FGridCoord Location = GameMode->GetGridManager()->WorldToGrid(SelectedUnitLocation); GameMode->GetGridManager()->IsObstacle(Location) || GameMode->GetBattleManager()->IsOccupied(Location)) return;
 		
 		if (SelectedUnitType == EUnitTypes::Brawler)
 		{
@@ -59,8 +59,6 @@ void UPlacementManager::PlaceUnit(bool bIsPlayer)
 			Unit = GameMode->World()->SpawnActor<ASniperUnit>(ASniperUnit::StaticClass(), SelectedUnitLocation, FRotator::ZeroRotator);
 		}
 
-		GameMode->GetBattleManager()->AddPlayerUnit(Unit);
-
 		Unit->SetTextureColor(UnitsColor);	
 		
 		PlayerUnitsPlaced[SelectedUnitType]--;
@@ -81,14 +79,16 @@ void UPlacementManager::PlaceUnit(bool bIsPlayer)
 			Unit = GameMode->World()->SpawnActor<ASniperUnit>(ASniperUnit::StaticClass(), SelectedUnitLocation, FRotator(0.0, -180.0, 0.0));
 		}
 
-		GameMode->GetBattleManager()->AddAIUnit(Unit);
-
 		Unit->SetTextureColor(UnitsColor < 4 ? UnitsColor + 1 : 0);	
 		
 		AIUnitsPlaced[SelectedUnitType]--;
 	}
 	
 	Unit->SetUnitPosition(GameMode->GetGridManager()->WorldToGrid(SelectedUnitLocation));
+
+	// Register the unit once its tile is known, so the occupancy index sees it.
+	if (bIsPlayer) GameMode->GetBattleManager()->AddPlayerUnit(Unit);
+	else GameMode->GetBattleManager()->AddAIUnit(Unit);
 	
 	SelectedUnitLocation = FVector(-1, -1, -1);
 	SelectedUnitType = EUnitTypes::None;
@@ -0,0 +1,333 @@
+#include "Game/Managers/ReplayManager.h"
+
+#include "Engine/World.h"
+#include "Game/Controllers/GamePlayerController.h"
+#include "Game/Managers/BattleManager.h"
+#include "Game/Managers/PlacementManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+
+namespace
+{
+	TAutoConsoleVariable<bool> CVarAutoSave(
+		TEXT("paa.Replay.AutoSave"),
+		true,
+		TEXT("Whether every finished match is saved to the replay folder (Saved/Replays)."));
+
+	/**
+	 * Finds the strategy game mode of a world.
+	 * @param World - The world.
+	 * @return The game mode, or nullptr (logging why) if the world does not run one.
+	 */
+	AStrategyGameMode* FindGameMode(UWorld* World)
+	{
+		AStrategyGameMode* GameMode = World ? Cast<AStrategyGameMode>(World->GetAuthGameMode()) : nullptr;
+		if (!GameMode || !GameMode->GetReplayManager())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Replays need a running strategy game mode"));
+			return nullptr;
+		}
+
+		return GameMode;
+	}
+
+	void SaveReplay(const TArray<FString>& Args, UWorld* World)
+	{
+		if (const AStrategyGameMode* GameMode = FindGameMode(World))
+		{
+			GameMode->GetReplayManager()->SaveRecording(Args.Num() > 0 ? Args[0] : FString());
+		}
+	}
+
+	void PlayReplay(const TArray<FString>& Args, UWorld* World)
+	{
+		AStrategyGameMode* GameMode = FindGameMode(World);
+		if (!GameMode) return;
+
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Usage: paa.Replay.Play <File>"));
+			return;
+		}
+
+		FBattleReplay Replay;
+		if (!Replay.LoadFromFile(UReplayManager::GetReplayPath(Args[0])))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Unable to load replay %s"), *UReplayManager::GetReplayPath(Args[0]));
+			return;
+		}
+
+		GameMode->GetReplayManager()->StartPlayback(MoveTemp(Replay));
+	}
+
+	/**
+	 * Re-executes a recorded match on the headless battle state as fast as possible, timing the runs.
+	 * Arguments: the replay file and an optional number of runs (default 1).
+	 */
+	void SimulateReplay(const TArray<FString>& Args)
+	{
+		if (Args.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Usage: paa.Replay.Simulate <File> [Runs]"));
+			return;
+		}
+
+		FBattleReplay Replay;
+		if (!Replay.LoadFromFile(UReplayManager::GetReplayPath(Args[0])))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Unable to load replay %s"), *UReplayManager::GetReplayPath(Args[0]));
+			return;
+		}
+
+		const int32 Runs = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 1;
+
+		FBattleState State;
+		int32 Diverged = INDEX_NONE;
+		const double Begin = FPlatformTime::Seconds();
+		for (int32 Run = 0; Run < Runs; ++Run)
+		{
+			Diverged = Replay.Simulate(State);
+		}
+		const double Seconds = FPlatformTime::Seconds() - Begin;
+
+		if (Diverged != INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Replay diverged at record %d of %d"), Diverged, Replay.Records.Num());
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Replay: %d records (%.1f s recorded), %d runs in %.3f ms (%.2f us per match), %s"),
+			Replay.Records.Num(), Replay.TimesMs.Num() > 0 ? Replay.TimesMs.Last() / 1000.0 : 0.0, Runs, Seconds * 1000.0,
+			Seconds * 1000000.0 / Runs, State.IsTeamDefeated(false) ? TEXT("player won") : State.IsTeamDefeated(true) ? TEXT("AI won") : TEXT("unfinished"));
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs SaveCommand(
+		TEXT("paa.Replay.Save"),
+		TEXT("Saves the recording of the current match. Argument: an optional file name in Saved/Replays."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SaveReplay));
+
+	FAutoConsoleCommandWithWorldAndArgs PlayCommand(
+		TEXT("paa.Replay.Play"),
+		TEXT("Plays a recorded match back in real time, from the begin screen. Argument: the file name in Saved/Replays."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&PlayReplay));
+
+	FAutoConsoleCommand SimulateCommand(
+		TEXT("paa.Replay.Simulate"),
+		TEXT("Re-executes a recorded match headless as fast as possible, timing it and checking it. Arguments: the file name, then an optional number of runs."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&SimulateReplay));
+}
+
+void UReplayManager::Initialize(AStrategyGameMode* GameModeRef)
+{
+	GameMode = GameModeRef;
+
+	if (GameMode.IsValid())
+	{
+		GameMode->OnGamePhaseChanged.RemoveDynamic(this, &UReplayManager::OnGamePhaseChanged);
+		GameMode->OnGamePhaseChanged.AddDynamic(this, &UReplayManager::OnGamePhaseChanged);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unable to register delegates for ReplayManager"));
+	}
+}
+
+bool UReplayManager::StartPlayback(FBattleReplay&& InReplay)
+{
+	const AGridManager* GridManager = GameMode->GetGridManager();
+
+	if (bPlaying || GameMode->GetCurrentPhase() != EGamePhase::Begin)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Replays can only be played from the begin screen"));
+		return false;
+	}
+
+	if (InReplay.SizeX != GridManager->GetGridSizeX() || InReplay.SizeY != GridManager->GetGridSizeY() || InReplay.Units.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("The replay was recorded on a %dx%d grid with %d units and cannot be played here"),
+			InReplay.SizeX, InReplay.SizeY, InReplay.Units.Num());
+		return false;
+	}
+
+	Replay = MoveTemp(InReplay);
+	NextRecord = 0;
+	bPlaying = true;
+	bBattleStarted = false;
+
+	// The damage stream derives from the seed; the recorded terrain wins over the generated one
+	// (the obstacle percentage or a pinned obstacle seed may differ from the recording's).
+	GameMode->ReseedMatch(Replay.Seed);
+	GameMode->TransitionToPhase(EGamePhase::Placement);
+	GameMode->GetGridManager()->SetObstacles(Replay.Obstacles);
+	GameMode->GetGridManager()->SetMovementCosts(Replay.MovementCost);
+	GameMode->SetTurn(Replay.Units[0].bPlayerTeam);
+
+	UE_LOG(LogTemp, Display, TEXT("Playing back a match of %d records"), Replay.Records.Num());
+
+	ScheduleNextRecord();
+	return true;
+}
+
+void UReplayManager::StopPlayback()
+{
+	if (!bPlaying) return;
+
+	bPlaying = false;
+	GetWorld()->GetTimerManager().ClearTimer(RecordTimer);
+
+	// Hand the match back to the player if it is their turn.
+	GameMode->SetTurn(GameMode->IsPlayerTurn());
+}
+
+bool UReplayManager::IsPlaying() const
+{
+	return bPlaying;
+}
+
+bool UReplayManager::SaveRecording(const FString& Filename) const
+{
+	FBattleReplay Recording = GameMode->GetBattleManager()->GetReplay();
+	if (Recording.Records.IsEmpty()) return false;
+
+	const FString Path = GetReplayPath(Filename.IsEmpty() ? FDateTime::Now().ToString() : Filename);
+	if (!Recording.SaveToFile(Path))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unable to save replay %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Saved replay %s (%d records, seed %d)"), *Path, Recording.Records.Num(), Recording.Seed);
+	return true;
+}
+
+FString UReplayManager::GetReplayPath(const FString& Filename)
+{
+	const FString Path = FPaths::IsRelative(Filename) ? FPaths::ProjectSavedDir() / TEXT("Replays") / Filename : Filename;
+	return FPaths::GetExtension(Path).IsEmpty() ? Path + TEXT(".paareplay") : Path;
+}
+
+void UReplayManager::OnGamePhaseChanged(EGamePhase NewPhase)
+{
+	if (NewPhase != EGamePhase::End) return;
+
+	// A played-back match is already on disk.
+	if (bPlaying) StopPlayback();
+	else if (CVarAutoSave.GetValueOnGameThread()) SaveRecording(FString());
+}
+
+void UReplayManager::ScheduleNextRecord()
+{
+	if (NextRecord >= Replay.Records.Num())
+	{
+		bPlaying = false;
+		CheckFinalState();
+		GameMode->SetTurn(GameMode->IsPlayerTurn());
+		return;
+	}
+
+	// Records are played with their recorded spacing; a short floor lets unit movement settle.
+	const uint32 Previous = NextRecord > 0 ? Replay.TimesMs[NextRecord - 1] : 0;
+	const float Delay = FMath::Max((Replay.TimesMs[NextRecord] - FMath::Min(Previous, Replay.TimesMs[NextRecord])) / 1000.f, 0.05f);
+
+	GetWorld()->GetTimerManager().SetTimer(RecordTimer, this, &UReplayManager::PlayNextRecord, Delay, false);
+}
+
+void UReplayManager::PlayNextRecord()
+{
+	if (!bPlaying) return;
+
+	UBattleManager* BattleManager = GameMode->GetBattleManager();
+	const TWeakObjectPtr<AGamePlayerController> PlayerController = GameMode->GetPlayerController();
+	const int32 Record = NextRecord++;
+	const FReplayAction Action = FBattleReplay::Decode(Replay.Records[Record]);
+
+	switch (Action.Type)
+	{
+	case EReplayRecord::Place:
+		{
+			// Placement turns alternate, so the recorded team must be the one placing now.
+			if (!Replay.Units.IsValidIndex(Action.Unit) || Replay.Units[Action.Unit].bPlayerTeam != GameMode->IsPlayerTurn())
+			{
+				Diverge(Record, TEXT("the placing team does not match"));
+				return;
+			}
+
+			UPlacementManager* PlacementManager = GameMode->GetPlacementManager();
+			PlacementManager->SetUnitLocation(GameMode->GetGridManager()->GridToWorld(Replay.ToCoord(Action.Cell)));
+			PlacementManager->SetUnitToPlace(Replay.Units[Action.Unit].Type);
+		}
+		break;
+	case EReplayRecord::Move:
+		{
+			ABaseUnit* Unit = BattleManager->GetUnitByIndex(Action.Unit);
+			const FGridCoord Tile = Replay.ToCoord(Action.Cell);
+			if (!Unit)
+			{
+				Diverge(Record, TEXT("the moving unit does not exist"));
+				return;
+			}
+
+			PlayerController->OnUnitClicked.Broadcast(Unit, true);
+			PlayerController->OnTileClicked.Broadcast(Tile, true);
+
+			if (Unit->GetPosition() != Tile)
+			{
+				Diverge(Record, TEXT("the unit did not reach the recorded tile"));
+				return;
+			}
+		}
+		break;
+	case EReplayRecord::Attack:
+		{
+			ABaseUnit* Unit = BattleManager->GetUnitByIndex(Action.Unit);
+			ABaseUnit* Target = BattleManager->GetUnitByIndex(Action.Target);
+			if (!Unit || !Target)
+			{
+				Diverge(Record, TEXT("the attacker or its target does not exist"));
+				return;
+			}
+
+			PlayerController->OnUnitClicked.Broadcast(Unit, false);
+			PlayerController->OnUnitClicked.Broadcast(Target, false);
+		}
+		break;
+	case EReplayRecord::Turn:
+		// The first battle turn starts by itself after the last placement; later ones passing to the other team are skips.
+		if (bBattleStarted && GameMode->IsPlayerTurn() != Action.bPlayerTurn) BattleManager->OnTurnSkipped();
+		bBattleStarted = true;
+
+		if (GameMode->IsPlayerTurn() != Action.bPlayerTurn)
+		{
+			Diverge(Record, TEXT("the acting team does not match"));
+			return;
+		}
+		break;
+	}
+
+	ScheduleNextRecord();
+}
+
+void UReplayManager::Diverge(const int32 Record, const TCHAR* Reason)
+{
+	UE_LOG(LogTemp, Error, TEXT("Replay diverged at record %d of %d: %s"), Record, Replay.Records.Num(), Reason);
+	StopPlayback();
+}
+
+void UReplayManager::CheckFinalState() const
+{
+	FBattleState Expected;
+	const int32 Diverged = Replay.Simulate(Expected);
+	const FBattleState& Played = GameMode->GetBattleManager()->GetBattleState();
+
+	const bool bMatches = Diverged == INDEX_NONE &&
+		Expected.Units.Position == Played.Units.Position && Expected.Units.LifePoints == Played.Units.LifePoints;
+
+	if (bMatches)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Replay finished: the played-back match matches the recording"));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Replay finished, but the played-back match differs from the recording (headless divergence at record %d)"), Diverged);
+	}
+}
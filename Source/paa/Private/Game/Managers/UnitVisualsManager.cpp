@@ -0,0 +1,108 @@
+#include "Game/Managers/UnitVisualsManager.h"
+
+namespace
+{
+	// The textures of the default content, used when no unit visuals asset is set.
+	const TCHAR* DefaultSniperTextures[] = {
+		TEXT("/Game/Textures/Units/Soldier1_Blue.Soldier1_Blue"),
+		TEXT("/Game/Textures/Units/Soldier1_Brown.Soldier1_Brown"),
+		TEXT("/Game/Textures/Units/Soldier1_Green.Soldier1_Green"),
+		TEXT("/Game/Textures/Units/Soldier1_Red.Soldier1_Red"),
+		TEXT("/Game/Textures/Units/Soldier1_Violet.Soldier1_Violet")
+	};
+
+	const TCHAR* DefaultBrawlerTextures[] = {
+		TEXT("/Game/Textures/Units/Soldier2_Blue.Soldier2_Blue"),
+		TEXT("/Game/Textures/Units/Soldier2_Brown.Soldier2_Brown"),
+		TEXT("/Game/Textures/Units/Soldier2_Green.Soldier2_Green"),
+		TEXT("/Game/Textures/Units/Soldier2_Red.Soldier2_Red"),
+		TEXT("/Game/Textures/Units/Soldier2_Violet.Soldier2_Violet")
+	};
+
+	/** Resolves the loaded textures of a list of paths, in order. */
+	void ResolveTextures(const TArray<FSoftObjectPath>& Paths, TArray<UTexture2D*>& OutTextures)
+	{
+		OutTextures.Reset(Paths.Num());
+
+		for (const FSoftObjectPath& Path : Paths)
+		{
+			UTexture2D* Texture = Cast<UTexture2D>(Path.ResolveObject());
+			if (!Texture) UE_LOG(LogTemp, Warning, TEXT("Failed to load texture: %s"), *Path.ToString());
+
+			OutTextures.Add(Texture);
+		}
+	}
+}
+
+void UUnitVisualsManager::Initialize(const TSoftObjectPtr<UUnitVisualsAsset>& InVisuals)
+{
+	Visuals = InVisuals;
+}
+
+void UUnitVisualsManager::Preload()
+{
+	if (bReady || Handle.IsValid()) return;
+
+	if (Visuals.IsNull())
+	{
+		for (const TCHAR* Path : DefaultSniperTextures) SniperPaths.Emplace(Path);
+		for (const TCHAR* Path : DefaultBrawlerTextures) BrawlerPaths.Emplace(Path);
+
+		RequestTextures();
+		return;
+	}
+
+	// The asset only holds soft references, so it is cheap to load; the textures follow once it is in.
+	Handle = Streamable.RequestAsyncLoad(Visuals.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &UUnitVisualsManager::OnVisualsAssetLoaded));
+}
+
+bool UUnitVisualsManager::IsReady() const
+{
+	return bReady;
+}
+
+UTexture2D* UUnitVisualsManager::GetTexture(const EUnitTypes Type, const int32 Color) const
+{
+	const TArray<UTexture2D*>& Textures = Type == EUnitTypes::Brawler ? BrawlerTextures : SniperTextures;
+	return Textures.IsValidIndex(Color) ? Textures[Color] : nullptr;
+}
+
+void UUnitVisualsManager::OnVisualsAssetLoaded()
+{
+	if (const UUnitVisualsAsset* Asset = Visuals.Get())
+	{
+		for (const TSoftObjectPtr<UTexture2D>& Texture : Asset->GetTextures(EUnitTypes::Sniper)) SniperPaths.Add(Texture.ToSoftObjectPath());
+		for (const TSoftObjectPtr<UTexture2D>& Texture : Asset->GetTextures(EUnitTypes::Brawler)) BrawlerPaths.Add(Texture.ToSoftObjectPath());
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to load unit visuals: %s"), *Visuals.ToString());
+	}
+
+	RequestTextures();
+}
+
+void UUnitVisualsManager::RequestTextures()
+{
+	TArray<FSoftObjectPath> Paths = SniperPaths;
+	Paths.Append(BrawlerPaths);
+	Paths.RemoveAll([](const FSoftObjectPath& Path) { return Path.IsNull(); });
+
+	if (Paths.IsEmpty())
+	{
+		OnTexturesLoaded();
+		return;
+	}
+
+	// The handle keeps the textures resident for the whole session once they are in.
+	Handle = Streamable.RequestAsyncLoad(Paths, FStreamableDelegate::CreateUObject(this, &UUnitVisualsManager::OnTexturesLoaded));
+}
+
+void UUnitVisualsManager::OnTexturesLoaded()
+{
+	ResolveTextures(SniperPaths, SniperTextures);
+	ResolveTextures(BrawlerPaths, BrawlerTextures);
+
+	bReady = true;
+	OnVisualsReady.Broadcast(); // Broadcast that the textures can be used.
+}
@@ -4,7 +4,9 @@
 #include "Game/Controllers/GamePlayerController.h"
 #include "Game/Managers/BattleManager.h"
 #include "Game/Managers/PlacementManager.h"
+#include "Game/Managers/ReplayManager.h"
 #include "Game/Managers/UIManager.h"
+#include "Game/Managers/UnitVisualsManager.h"
 #include "Kismet/GameplayStatics.h"
 
 AStrategyGameMode::AStrategyGameMode()
@@ -19,6 +21,13 @@ void AStrategyGameMode::TransitionToPhase(EGamePhase NewPhase)
 {
 	CurrentPhase = NewPhase;
 
+	// A new match restarts every random stream from its seed, before anything draws from them.
+	if (CurrentPhase == EGamePhase::Begin)
+	{
+		Random.Initialize(MatchSeed != 0 ? MatchSeed : FMath::Rand());
+		UE_LOG(LogTemp, Display, TEXT("Starting match with seed %d"), Random.GetSeed());
+	}
+
 	// Broadcast the phase change to any listeners.
 	OnGamePhaseChanged.Broadcast(CurrentPhase);
 
@@ -26,6 +35,7 @@ void AStrategyGameMode::TransitionToPhase(EGamePhase NewPhase)
 	switch (CurrentPhase)
 	{
 	case EGamePhase::Begin:
+		UnitVisualsManager->Preload(); // Streams the unit textures in while the player is on the begin screen.
 		GridManager->GenerateGrid();
 		break;
 	case EGamePhase::CoinFlip:
@@ -68,6 +78,16 @@ bool AStrategyGameMode::IsPlayerTurn() const
 	return bIsPlayerTurn;
 }
 
+EGamePhase AStrategyGameMode::GetCurrentPhase() const
+{
+	return CurrentPhase;
+}
+
+bool AStrategyGameMode::IsReplaying() const
+{
+	return ReplayManager && ReplayManager->IsPlaying();
+}
+
 TWeakObjectPtr<AGamePlayerController> AStrategyGameMode::GetPlayerController() const
 {
 	return PlayerController;
@@ -78,6 +98,22 @@ AGridManager* AStrategyGameMode::GetGridManager()
 	return GridManager.Get();
 }
 
+FMatchRng& AStrategyGameMode::GetRandomStream(const ERandomStream Stream)
+{
+	return Random.Get(Stream);
+}
+
+int32 AStrategyGameMode::GetMatchSeed() const
+{
+	return Random.GetSeed();
+}
+
+void AStrategyGameMode::ReseedMatch(const int32 Seed)
+{
+	Random.Initialize(Seed);
+	UE_LOG(LogTemp, Display, TEXT("Match reseeded with seed %d"), Seed);
+}
+
 UPlacementManager* AStrategyGameMode::GetPlacementManager()
 {
 	return PlacementManager;
@@ -88,6 +124,16 @@ UBattleManager* AStrategyGameMode::GetBattleManager()
 	return BattleManager;
 }
 
+UReplayManager* AStrategyGameMode::GetReplayManager()
+{
+	return ReplayManager;
+}
+
+UUnitVisualsManager* AStrategyGameMode::GetUnitVisualsManager()
+{
+	return UnitVisualsManager;
+}
+
 void AStrategyGameMode::BeginPlay()
 {
 	Super::BeginPlay();
@@ -114,6 +160,14 @@ void AStrategyGameMode::BeginPlay()
 	BattleManager = NewObject<UBattleManager>(this);
 	BattleManager->Initialize(this);
 
+	// Initialize the replay manager.
+	ReplayManager = NewObject<UReplayManager>(this);
+	ReplayManager->Initialize(this);
+
+	// Initialize the unit visuals manager, which the UI and the units read their textures from.
+	UnitVisualsManager = NewObject<UUnitVisualsManager>(this);
+	UnitVisualsManager->Initialize(UnitVisuals);
+
 	// Initialize the UI manager.
 	UIManager = NewObject<UUIManager>(this);
 	UIManager->Initialize(this);
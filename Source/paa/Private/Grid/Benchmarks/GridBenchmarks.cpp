@@ -0,0 +1,829 @@
+#include "CoreMinimal.h"
+#include "Algo/Reverse.h"
+#include "Grid/GridBitboard.h"
+#include "Grid/GridHierarchy.h"
+#include "Grid/GridTypes.h"
+#include "Grid/GridVisibility.h"
+#include "Grid/Utils/ObstaclesUtilities.h"
+#include "Grid/Utils/PathfindingUtilities.h"
+#include "HAL/IConsoleManager.h"
+#include "Systems/BattleRules.h"
+#include "Systems/InfluenceMap.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Development-only benchmarks for the grid algorithms, exposed as console commands.
+ * They operate on bare FGridData instances, so no world or tile actors are required.
+ */
+namespace GridBenchmarks
+{
+	/**
+	 * Builds a grid with randomly scattered obstacles.
+	 * @param Size - The width and height of the grid.
+	 * @param ObstaclePercentage - The chance of each cell being an obstacle.
+	 * @param Stream - The random stream to draw from.
+	 * @return The generated grid.
+	 */
+	FGridData MakeRandomGrid(const int32 Size, const float ObstaclePercentage, FRandomStream& Stream)
+	{
+		FGridData Grid;
+		Grid.Init(Size, Size);
+
+		for (int32 Index = 0; Index < Grid.Num(); ++Index)
+		{
+			Grid.Obstacles[Index] = Stream.FRand() < ObstaclePercentage;
+		}
+
+		return Grid;
+	}
+
+	/**
+	 * Picks a random walkable cell.
+	 * @param Grid - The grid data.
+	 * @param Stream - The random stream to draw from.
+	 * @return The coordinate of a walkable cell.
+	 */
+	FGridCoord RandomFreeCell(const FGridData& Grid, FRandomStream& Stream)
+	{
+		while (true)
+		{
+			const int32 Index = Stream.RandRange(0, Grid.Num() - 1);
+			if (!Grid.IsObstacle(Index)) return Grid.ToCoord(Index);
+		}
+	}
+
+	/**
+	 * The previous A* implementation (open list re-sorted on every pop, scores re-allocated per query),
+	 * kept as the baseline the heap-based search is measured against.
+	 */
+	TArray<FGridCoord> LegacyGetPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied)
+	{
+		TArray<FGridCoord> Path;
+
+		const int32 Start = Grid.ToIndex(StartTile);
+		const int32 End = Grid.ToIndex(EndTile);
+
+		if (Start == End)
+		{
+			Path.Add(StartTile);
+			return Path;
+		}
+
+		TArray<int32> CameFrom;
+		TArray<float> GScore;
+		TArray<float> FScore;
+		CameFrom.Init(INDEX_NONE, Grid.Num());
+		GScore.Init(TNumericLimits<float>::Max(), Grid.Num());
+		FScore.Init(TNumericLimits<float>::Max(), Grid.Num());
+
+		GScore[Start] = 0.0f;
+		FScore[Start] = StartTile.Distance(EndTile);
+
+		TArray<int32> OpenSet;
+		TBitArray<> OpenSetCheck(false, Grid.Num());
+		OpenSet.Add(Start);
+		OpenSetCheck[Start] = true;
+
+		while (!OpenSet.IsEmpty())
+		{
+			OpenSet.Sort([&FScore](const int32 A, const int32 B) { return FScore[A] < FScore[B]; });
+
+			const int32 Current = OpenSet[0];
+			OpenSet.RemoveAt(0);
+			OpenSetCheck[Current] = false;
+
+			if (Current == End)
+			{
+				for (int32 ReconstructCurrent = End; ReconstructCurrent != Start; ReconstructCurrent = CameFrom[ReconstructCurrent])
+				{
+					Path.Add(Grid.ToCoord(ReconstructCurrent));
+				}
+				Path.Add(StartTile);
+				Algo::Reverse(Path);
+				return Path;
+			}
+
+			int32 Neighbors[4];
+			const int32 NeighborCount = Grid.GetNeighbors(Current, Neighbors);
+
+			for (int32 i = 0; i < NeighborCount; ++i)
+			{
+				const int32 Neighbor = Neighbors[i];
+				if (Grid.IsObstacle(Neighbor) || Occupied[Neighbor]) continue;
+
+				const float TentativeGScore = GScore[Current] + 1.0f;
+				if (TentativeGScore < GScore[Neighbor])
+				{
+					CameFrom[Neighbor] = Current;
+					GScore[Neighbor] = TentativeGScore;
+					FScore[Neighbor] = TentativeGScore + Grid.ToCoord(Neighbor).Distance(EndTile);
+
+					if (!OpenSetCheck[Neighbor])
+					{
+						OpenSet.Add(Neighbor);
+						OpenSetCheck[Neighbor] = true;
+					}
+				}
+			}
+		}
+
+		return Path;
+	}
+
+	/**
+	 * Times the legacy and heap-based A* on the same random queries for several grid sizes.
+	 */
+	void RunPathfinding()
+	{
+		struct FCase { int32 Size; int32 Queries; int32 LegacyQueries; };
+		const FCase Cases[] = { { 25, 1000, 1000 }, { 100, 200, 50 }, { 500, 50, 3 } };
+
+		for (const FCase& Case : Cases)
+		{
+			FRandomStream Stream(Case.Size);
+			const FGridData Grid = MakeRandomGrid(Case.Size, 0.3f, Stream);
+			const TBitArray<> Occupied(false, Grid.Num());
+
+			TArray<TPair<FGridCoord, FGridCoord>> Queries;
+			for (int32 i = 0; i < Case.Queries; ++i)
+			{
+				Queries.Add({ RandomFreeCell(Grid, Stream), RandomFreeCell(Grid, Stream) });
+			}
+
+			FGridSearchScratch Scratch;
+			int32 Mismatches = 0;
+
+			double Begin = FPlatformTime::Seconds();
+			for (const TPair<FGridCoord, FGridCoord>& Query : Queries)
+			{
+				UPathfindingUtilities::GetPath(Grid, Query.Key, Query.Value, Occupied, Scratch);
+			}
+			const double HeapSeconds = FPlatformTime::Seconds() - Begin;
+
+			TArray<int32> LegacyLengths;
+			LegacyLengths.Reserve(Case.LegacyQueries);
+
+			Begin = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Case.LegacyQueries; ++i)
+			{
+				LegacyLengths.Add(LegacyGetPath(Grid, Queries[i].Key, Queries[i].Value, Occupied).Num());
+			}
+			const double LegacySeconds = FPlatformTime::Seconds() - Begin;
+
+			// Both searches are optimal, so their paths must have the same length.
+			for (int32 i = 0; i < Case.LegacyQueries; ++i)
+			{
+				if (LegacyLengths[i] != UPathfindingUtilities::GetPath(Grid, Queries[i].Key, Queries[i].Value, Occupied, Scratch).Num()) Mismatches++;
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Pathfinding %dx%d: heap A* %.4f ms/query (%d queries), legacy A* %.4f ms/query (%d queries), %d length mismatches"),
+				Case.Size, Case.Size, HeapSeconds * 1000.0 / Case.Queries, Case.Queries,
+				LegacySeconds * 1000.0 / Case.LegacyQueries, Case.LegacyQueries, Mismatches);
+		}
+	}
+
+	/**
+	 * Times Jump Point Search against A* on the same random queries, with some tiles occupied,
+	 * and checks every path has the same length and only steps onto free tiles.
+	 */
+	void RunJumpPoint()
+	{
+		struct FCase { int32 Size; int32 Queries; };
+		const FCase Cases[] = { { 25, 1000 }, { 100, 200 }, { 500, 50 }, { 1000, 20 } };
+
+		for (const FCase& Case : Cases)
+		{
+			FRandomStream Stream(Case.Size);
+			const FGridData Grid = MakeRandomGrid(Case.Size, 0.2f, Stream);
+
+			TBitArray<> Occupied(false, Grid.Num());
+			for (int32 i = 0; i < Grid.Num() / 50; ++i) Occupied[Grid.ToIndex(RandomFreeCell(Grid, Stream))] = true;
+
+			TArray<TPair<FGridCoord, FGridCoord>> Queries;
+			while (Queries.Num() < Case.Queries)
+			{
+				const FGridCoord Start = RandomFreeCell(Grid, Stream);
+				const FGridCoord End = RandomFreeCell(Grid, Stream);
+				if (!Occupied[Grid.ToIndex(End)]) Queries.Add({ Start, End });
+			}
+
+			FGridSearchScratch Scratch;
+			TArray<int32> Lengths;
+
+			double Begin = FPlatformTime::Seconds();
+			for (const TPair<FGridCoord, FGridCoord>& Query : Queries)
+			{
+				Lengths.Add(UPathfindingUtilities::GetPath(Grid, Query.Key, Query.Value, Occupied, Scratch).Num());
+			}
+			const double AStarSeconds = FPlatformTime::Seconds() - Begin;
+
+			TArray<TArray<FGridCoord>> JumpPaths;
+			Begin = FPlatformTime::Seconds();
+			for (const TPair<FGridCoord, FGridCoord>& Query : Queries)
+			{
+				JumpPaths.Add(UPathfindingUtilities::GetJumpPointPath(Grid, Query.Key, Query.Value, Occupied, Scratch));
+			}
+			const double JumpSeconds = FPlatformTime::Seconds() - Begin;
+
+			int32 Mismatches = 0;
+			for (int32 i = 0; i < Queries.Num(); ++i)
+			{
+				const TArray<FGridCoord>& Path = JumpPaths[i];
+				bool bValid = Path.Num() == Lengths[i];
+
+				for (int32 Step = 1; Step < Path.Num() && bValid; ++Step)
+				{
+					const int32 Index = Grid.ToIndex(Path[Step]);
+					bValid = Path[Step].Distance(Path[Step - 1]) == 1 && Index != INDEX_NONE && !Grid.IsObstacle(Index) && !Occupied[Index];
+				}
+
+				if (!bValid) Mismatches++;
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Jump point %dx%d: A* %.4f ms/query, JPS %.4f ms/query (%d queries), %d mismatches"),
+				Case.Size, Case.Size, AStarSeconds * 1000.0 / Case.Queries, JumpSeconds * 1000.0 / Case.Queries, Case.Queries, Mismatches);
+		}
+	}
+
+	/**
+	 * Times the sector hierarchy (HPA*) against the flat A* on the same distant queries over large connected maps:
+	 * the graph build, the query times, the path length overhead and the repair after a few tiles change occupancy.
+	 */
+	void RunHierarchy()
+	{
+		struct FCase { int32 Size; int32 Queries; int32 FlatQueries; };
+		const FCase Cases[] = { { 256, 200, 200 }, { 1024, 100, 20 } };
+		constexpr int32 ClusterSize = 16;
+
+		for (const FCase& Case : Cases)
+		{
+			FGridData Grid;
+			Grid.Init(Case.Size, Case.Size);
+			FMatchRng Carve(Case.Size);
+			UObstaclesUtilities::CarveObstacles(Grid, 0.3f, Carve);
+
+			FRandomStream Stream(Case.Size);
+			TBitArray<> Occupied(false, Grid.Num());
+
+			TArray<TPair<FGridCoord, FGridCoord>> Queries;
+			while (Queries.Num() < Case.Queries)
+			{
+				const FGridCoord Start = RandomFreeCell(Grid, Stream);
+				const FGridCoord End = RandomFreeCell(Grid, Stream);
+				if (Start.Distance(End) > Case.Size / 4) Queries.Add({ Start, End });
+			}
+
+			FGridHierarchy Hierarchy;
+			double Begin = FPlatformTime::Seconds();
+			Hierarchy.Build(Grid, ClusterSize);
+			const double BuildSeconds = FPlatformTime::Seconds() - Begin;
+
+			FGridSearchScratch Scratch;
+			TArray<int32> HierarchyLengths;
+
+			Begin = FPlatformTime::Seconds();
+			for (const TPair<FGridCoord, FGridCoord>& Query : Queries)
+			{
+				HierarchyLengths.Add(Hierarchy.FindPath(Grid, Query.Key, Query.Value, Occupied, Scratch).Num());
+			}
+			const double HierarchySeconds = FPlatformTime::Seconds() - Begin;
+
+			TArray<int32> FlatLengths;
+			Begin = FPlatformTime::Seconds();
+			for (int32 i = 0; i < Case.FlatQueries; ++i)
+			{
+				FlatLengths.Add(UPathfindingUtilities::GetPath(Grid, Queries[i].Key, Queries[i].Value, Occupied, Scratch).Num());
+			}
+			const double FlatSeconds = FPlatformTime::Seconds() - Begin;
+
+			// Hierarchical paths may be a little longer, never shorter, and must exist whenever a flat one does.
+			int32 Failures = 0;
+			int64 HierarchySteps = 0;
+			int64 FlatSteps = 0;
+			for (int32 i = 0; i < Case.FlatQueries; ++i)
+			{
+				if ((FlatLengths[i] == 0) != (HierarchyLengths[i] == 0) || HierarchyLengths[i] < FlatLengths[i]) Failures++;
+				HierarchySteps += HierarchyLengths[i];
+				FlatSteps += FlatLengths[i];
+			}
+
+			// A few units stepping onto new tiles only rebuilds the sectors around them.
+			for (int32 i = 0; i < 8; ++i) Occupied[Grid.ToIndex(RandomFreeCell(Grid, Stream))] = true;
+			Begin = FPlatformTime::Seconds();
+			const int32 Repaired = Hierarchy.Sync(Grid, Occupied);
+			const double RepairSeconds = FPlatformTime::Seconds() - Begin;
+
+			UE_LOG(LogTemp, Display, TEXT("Hierarchy %dx%d: build %.2f ms (%d nodes), HPA* %.4f ms/query (%d queries), flat A* %.4f ms/query (%d queries), paths %.2f%% longer, %d failures, repair of %d sectors %.3f ms"),
+				Case.Size, Case.Size, BuildSeconds * 1000.0, Hierarchy.GetNumNodes(),
+				HierarchySeconds * 1000.0 / Case.Queries, Case.Queries, FlatSeconds * 1000.0 / Case.FlatQueries, Case.FlatQueries,
+				FlatSteps > 0 ? (double(HierarchySteps) / FlatSteps - 1.0) * 100.0 : 0.0, Failures, Repaired, RepairSeconds * 1000.0);
+		}
+	}
+
+	/**
+	 * Times the obstacle generator on small and large grids and validates every generated layout:
+	 * the obstacle count must match the percentage, the free tiles must be connected and
+	 * the same seed must reproduce the same mask.
+	 */
+	void RunObstacles()
+	{
+		struct FCase { int32 Size; int32 Seeds; };
+		const FCase Cases[] = { { 25, 100 }, { 1000, 5 } };
+		constexpr float ObstaclePercentage = 0.3f;
+
+		for (const FCase& Case : Cases)
+		{
+			FGridData Grid;
+			Grid.Init(Case.Size, Case.Size);
+
+			const int32 ExpectedObstacles = FMath::FloorToInt(Grid.Num() * ObstaclePercentage);
+			int32 Failures = 0;
+			double CarveSeconds = 0.0;
+
+			for (int32 Seed = 1; Seed <= Case.Seeds; ++Seed)
+			{
+				FMatchRng Stream(Seed);
+				const double Begin = FPlatformTime::Seconds();
+				UObstaclesUtilities::CarveObstacles(Grid, ObstaclePercentage, Stream);
+				CarveSeconds += FPlatformTime::Seconds() - Begin;
+
+				const TBitArray<> FirstMask = Grid.Obstacles;
+
+				// Regenerating with the same seed must give the same layout.
+				FMatchRng Replay(Seed);
+				UObstaclesUtilities::CarveObstacles(Grid, ObstaclePercentage, Replay);
+
+				const bool bCountMatches = Grid.Obstacles.CountSetBits() == ExpectedObstacles;
+				const bool bConnected = UObstaclesUtilities::AreFreeTilesConnected(Grid);
+				const bool bDeterministic = Grid.Obstacles == FirstMask;
+
+				if (!bCountMatches || !bConnected || !bDeterministic)
+				{
+					Failures++;
+					UE_LOG(LogTemp, Error, TEXT("Obstacles %dx%d seed %d: count ok %d, connected %d, deterministic %d"),
+						Case.Size, Case.Size, Seed, bCountMatches, bConnected, bDeterministic);
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Obstacles %dx%d: %.3f ms/map (%d seeds), %d failed validation"),
+				Case.Size, Case.Size, CarveSeconds * 1000.0 / Case.Seeds, Case.Seeds, Failures);
+		}
+	}
+
+	/**
+	 * Returns whether two battle states hold the same units, occupancy, turn and random stream.
+	 */
+	bool AreStatesEqual(const FBattleState& A, const FBattleState& B)
+	{
+		return A.Occupied == B.Occupied && A.bPlayerTurn == B.bPlayerTurn &&
+			A.Random == B.Random &&
+			A.Units.Position == B.Units.Position && A.Units.LifePoints == B.Units.LifePoints && A.Units.Action == B.Units.Action;
+	}
+
+	/**
+	 * Plays random battles on the headless rules: every unit of the acting team moves to a random legal tile
+	 * and attacks a random enemy in range. Every action is also undone once and checked against a copy of the state.
+	 */
+	void RunBattleRules()
+	{
+		constexpr int32 Games = 1000;
+		constexpr int32 MaxTurns = 200;
+
+		// The stats of ABrawlerUnit and ASniperUnit.
+		FBattleUnitDesc Brawler;
+		Brawler.Type = EUnitTypes::Brawler;
+		Brawler.LifePoints = 40;
+		Brawler.MovementRange = 6;
+		Brawler.AttackRange = 1;
+		Brawler.DamageMin = 1;
+		Brawler.DamageMax = 6;
+
+		FBattleUnitDesc Sniper;
+		Sniper.Type = EUnitTypes::Sniper;
+		Sniper.LifePoints = 20;
+		Sniper.MovementRange = 3;
+		Sniper.AttackRange = 10;
+		Sniper.DamageMin = 4;
+		Sniper.DamageMax = 8;
+
+		FBattleRules Rules;
+		TArray<FGridCoord> Moves;
+		TArray<int32> Targets;
+		int64 Turns = 0;
+		int64 Actions = 0;
+		int32 UndoFailures = 0;
+		int32 PlayerWins = 0;
+		double Seconds = 0.0;
+
+		for (int32 Game = 0; Game < Games; ++Game)
+		{
+			FRandomStream Stream(Game + 1);
+			FBattleState State;
+			State.Reset(MakeRandomGrid(25, 0.2f, Stream));
+			State.Random.Initialize(Game + 1);
+
+			for (const bool bPlayerTeam : { true, false })
+			{
+				for (FBattleUnitDesc Desc : { Brawler, Sniper })
+				{
+					do { Desc.Position = RandomFreeCell(State.Grid, Stream); } while (State.FindUnitAt(Desc.Position) != INDEX_NONE);
+					Desc.bPlayerTeam = bPlayerTeam;
+					State.AddUnit(Desc);
+				}
+			}
+
+			const double Begin = FPlatformTime::Seconds();
+			for (int32 Turn = 0; Turn < MaxTurns && !State.IsTeamDefeated(true) && !State.IsTeamDefeated(false); ++Turn, ++Turns)
+			{
+				for (int32 Unit = 0; Unit < State.Units.Num(); ++Unit)
+				{
+					if (!FBattleRules::CanAct(State, Unit)) continue;
+
+					FBattleUndo Undo;
+					Rules.GetMoves(State, Unit, Moves);
+					if (Moves.Num() > 0)
+					{
+						const FGridCoord Tile = Moves[Stream.RandHelper(Moves.Num())];
+
+						// Undo must restore the exact state.
+						if (Game < 10)
+						{
+							const FBattleState Before = State;
+							FBattleRules::ApplyMove(State, Unit, Tile, Undo);
+							FBattleRules::Undo(State, Undo);
+							if (!AreStatesEqual(Before, State)) UndoFailures++;
+						}
+
+						FBattleRules::ApplyMove(State, Unit, Tile, Undo);
+						Actions++;
+					}
+
+					Targets.Reset();
+					for (int32 Target = 0; Target < State.Units.Num(); ++Target)
+					{
+						if (FBattleRules::CanAttack(State, Unit, Target)) Targets.Add(Target);
+					}
+
+					if (Targets.Num() > 0)
+					{
+						const int32 Target = Targets[Stream.RandHelper(Targets.Num())];
+
+						// Random stream included.
+						if (Game < 10)
+						{
+							const FBattleState Before = State;
+							FBattleRules::ApplyAttack(State, Unit, Target, Undo);
+							FBattleRules::Undo(State, Undo);
+							if (!AreStatesEqual(Before, State)) UndoFailures++;
+						}
+
+						FBattleRules::ApplyAttack(State, Unit, Target, Undo);
+						Actions++;
+					}
+				}
+
+				FBattleRules::EndTurn(State);
+			}
+			Seconds += FPlatformTime::Seconds() - Begin;
+
+			if (State.IsTeamDefeated(false)) PlayerWins++;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Battle rules: %d games, %lld turns, %lld actions in %.3f ms (%.0f turns/s), player won %d, %d undo mismatches"),
+			Games, Turns, Actions, Seconds * 1000.0, Turns / FMath::Max(Seconds, UE_DOUBLE_SMALL_NUMBER), PlayerWins, UndoFailures);
+	}
+
+	/**
+	 * Times movement ranges computed with a BFS distance field against bitboard dilation on the same random queries,
+	 * on small and wide grids, and checks both give the same tiles.
+	 */
+	void RunBitboard()
+	{
+		struct FCase { int32 Size; int32 Queries; int32 Range; };
+		const FCase Cases[] = { { 25, 10000, 6 }, { 100, 2000, 10 }, { 500, 200, 40 } };
+
+		for (const FCase& Case : Cases)
+		{
+			FRandomStream Stream(Case.Size);
+			const FGridData Grid = MakeRandomGrid(Case.Size, 0.3f, Stream);
+
+			// Some units standing around, so occupancy is part of the walkable mask.
+			TBitArray<> Occupied(false, Grid.Num());
+			for (int32 i = 0; i < Grid.Num() / 50; ++i) Occupied[Grid.ToIndex(RandomFreeCell(Grid, Stream))] = true;
+
+			TArray<FGridCoord> Sources;
+			for (int32 i = 0; i < Case.Queries; ++i) Sources.Add(RandomFreeCell(Grid, Stream));
+
+			TArray<int32> Distance;
+			FGridBucketQueue Queue;
+			int64 BfsTiles = 0;
+
+			double Begin = FPlatformTime::Seconds();
+			for (const FGridCoord& Source : Sources)
+			{
+				UPathfindingUtilities::GetDistanceField(Grid, Grid.ToIndex(Source), Occupied, Distance, Queue);
+				for (const int32 Steps : Distance) BfsTiles += Steps != INDEX_NONE && Steps <= Case.Range;
+			}
+			const double BfsSeconds = FPlatformTime::Seconds() - Begin;
+
+			FGridBitboard Walkable;
+			FGridBitboard Reach;
+			int64 BitboardTiles = 0;
+
+			Begin = FPlatformTime::Seconds();
+			for (const FGridCoord& Source : Sources)
+			{
+				Walkable.SetWalkable(Grid, Occupied);
+				Reach.Init(Grid.SizeX, Grid.SizeY);
+				Reach.Set(Source, true);
+				Reach.Dilate(Walkable, Case.Range);
+				BitboardTiles += Reach.CountSetBits();
+			}
+			const double BitboardSeconds = FPlatformTime::Seconds() - Begin;
+
+			// Tile by tile on a sample of the queries.
+			int32 Mismatches = 0;
+			for (int32 i = 0; i < FMath::Min(Case.Queries, 100); ++i)
+			{
+				UPathfindingUtilities::GetDistanceField(Grid, Grid.ToIndex(Sources[i]), Occupied, Distance, Queue);
+				Reach.Init(Grid.SizeX, Grid.SizeY);
+				Reach.Set(Sources[i], true);
+				Reach.Dilate(Walkable, Case.Range);
+
+				for (int32 Index = 0; Index < Grid.Num(); ++Index)
+				{
+					const bool bInRange = Distance[Index] != INDEX_NONE && Distance[Index] <= Case.Range;
+					if (bInRange != Reach.Get(Grid.ToCoord(Index))) { Mismatches++; break; }
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Bitboard %dx%d range %d: BFS %.4f ms/query, dilation %.4f ms/query (%d queries), tiles %lld vs %lld, %d mismatches"),
+				Case.Size, Case.Size, Case.Range, BfsSeconds * 1000.0 / Case.Queries, BitboardSeconds * 1000.0 / Case.Queries,
+				Case.Queries, BfsTiles, BitboardTiles, Mismatches);
+		}
+	}
+
+	/**
+	 * Times building the line-of-sight cache and sniper-range visibility queries answered by the cache against rays
+	 * cast on demand, and checks both agree.
+	 */
+	void RunLineOfSight()
+	{
+		struct FCase { int32 Size; int32 Queries; };
+		const FCase Cases[] = { { 25, 200000 }, { 64, 200000 } };
+		constexpr int32 Range = 10; // The sniper's attack range.
+
+		for (const FCase& Case : Cases)
+		{
+			FRandomStream Stream(Case.Size);
+			const FGridData Grid = MakeRandomGrid(Case.Size, 0.2f, Stream);
+
+			double Begin = FPlatformTime::Seconds();
+			FGridVisibility Visibility;
+			Visibility.Build(Grid, FGridVisibility::MaxRange);
+			const double BuildSeconds = FPlatformTime::Seconds() - Begin;
+
+			// Pairs within range, as a sniper picking targets would ask.
+			TArray<TPair<FGridCoord, FGridCoord>> Pairs;
+			for (int32 i = 0; i < Case.Queries; ++i)
+			{
+				const FGridCoord From = RandomFreeCell(Grid, Stream);
+				const int32 OffsetY = Stream.RandRange(-Range, Range);
+				const int32 Reach = Range - FMath::Abs(OffsetY);
+				Pairs.Add({ From, FGridCoord(From.X + Stream.RandRange(-Reach, Reach), From.Y + OffsetY) });
+			}
+
+			int32 RayVisible = 0;
+			Begin = FPlatformTime::Seconds();
+			for (const TPair<FGridCoord, FGridCoord>& Pair : Pairs) RayVisible += FGridVisibility::HasLineOfSight(Grid, Pair.Key, Pair.Value);
+			const double RaySeconds = FPlatformTime::Seconds() - Begin;
+
+			int32 CachedVisible = 0;
+			Begin = FPlatformTime::Seconds();
+			for (const TPair<FGridCoord, FGridCoord>& Pair : Pairs) CachedVisible += Visibility.IsVisible(Grid, Pair.Key, Pair.Value);
+			const double CachedSeconds = FPlatformTime::Seconds() - Begin;
+
+			// Whole areas against rays, tile by tile, on a sample of the sources.
+			int32 Mismatches = 0;
+			FGridBitboard Area;
+			for (int32 i = 0; i < 100; ++i)
+			{
+				const FGridCoord Center = Pairs[i].Key;
+				Area.Init(Grid.SizeX, Grid.SizeY);
+				Visibility.AddVisibleArea(Grid, Center, Range, Area);
+
+				for (int32 Index = 0; Index < Grid.Num(); ++Index)
+				{
+					const FGridCoord Tile = Grid.ToCoord(Index);
+					const bool bVisible = Center.Distance(Tile) <= Range && FGridVisibility::HasLineOfSight(Grid, Tile, Center);
+					if (bVisible != Area.Get(Tile)) { Mismatches++; break; }
+				}
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Line of sight %dx%d range %d: build %.3f ms, rays %.1f ns/query, cache %.1f ns/query (%d queries), visible %d vs %d, %d mismatches"),
+				Case.Size, Case.Size, Range, BuildSeconds * 1000.0, RaySeconds * 1e9 / Case.Queries, CachedSeconds * 1e9 / Case.Queries,
+				Case.Queries, RayVisible, CachedVisible, Mismatches);
+		}
+	}
+
+	/**
+	 * Times building the AI's influence map from scratch against updating it after single moves on random 25x25 battles,
+	 * and checks the updated support and distance layers against a fresh build (threat stamps keep the occupancy they
+	 * were made with, so only those two layers must match exactly).
+	 */
+	void RunInfluence()
+	{
+		constexpr int32 Battles = 200;
+		constexpr int32 MovesPerBattle = 50;
+
+		FBattleUnitDesc Sniper;
+		Sniper.Type = EUnitTypes::Sniper;
+		Sniper.LifePoints = 20;
+		Sniper.MovementRange = 3;
+		Sniper.AttackRange = 10;
+		Sniper.DamageMin = 4;
+		Sniper.DamageMax = 8;
+
+		FInfluenceMap Influence;
+		FInfluenceMap Fresh;
+		double BuildSeconds = 0.0;
+		double UpdateSeconds = 0.0;
+		int32 Mismatches = 0;
+
+		for (int32 Battle = 0; Battle < Battles; ++Battle)
+		{
+			FRandomStream Stream(Battle + 1);
+			FBattleState State;
+			State.Reset(MakeRandomGrid(25, 0.2f, Stream));
+
+			for (int32 i = 0; i < 6; ++i)
+			{
+				FBattleUnitDesc Desc = Sniper;
+				do { Desc.Position = RandomFreeCell(State.Grid, Stream); } while (State.FindUnitAt(Desc.Position) != INDEX_NONE);
+				Desc.bPlayerTeam = i % 2 == 0;
+				State.AddUnit(Desc);
+			}
+
+			double Begin = FPlatformTime::Seconds();
+			Influence.Build(State, false);
+			BuildSeconds += FPlatformTime::Seconds() - Begin;
+
+			for (int32 Move = 0; Move < MovesPerBattle; ++Move)
+			{
+				const int32 Unit = Stream.RandRange(0, State.Units.Num() - 1);
+				FGridCoord To;
+				do { To = RandomFreeCell(State.Grid, Stream); } while (State.FindUnitAt(To) != INDEX_NONE);
+
+				State.Occupied[State.Grid.ToIndex(State.Units.Position[Unit])] = false;
+				State.Occupied[State.Grid.ToIndex(To)] = true;
+				State.Units.Position[Unit] = To;
+
+				Begin = FPlatformTime::Seconds();
+				Influence.UpdateUnit(State, Unit);
+				UpdateSeconds += FPlatformTime::Seconds() - Begin;
+
+				Fresh.Build(State, false);
+				for (const EInfluenceLayer Layer : { EInfluenceLayer::Support, EInfluenceLayer::TargetDistance })
+				{
+					const TConstArrayView<int32> Updated = Influence.GetLayer(Layer);
+					const TConstArrayView<int32> Built = Fresh.GetLayer(Layer);
+					if (FMemory::Memcmp(Updated.GetData(), Built.GetData(), Updated.Num() * sizeof(int32)) != 0) Mismatches++;
+				}
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Influence 25x25, 6 units: build %.4f ms, update after a move %.4f ms, %d layer mismatches"),
+			BuildSeconds * 1000.0 / Battles, UpdateSeconds * 1000.0 / (Battles * MovesPerBattle), Mismatches);
+	}
+
+	/**
+	 * Times hover previews served from one bounded path tree per selection against an A* query per hovered tile,
+	 * hovering every tile around the selected unit, and checks both give paths of the same movement cost.
+	 */
+	void RunPathPreview()
+	{
+		struct FCase { int32 Size; bool bCosts; };
+		const FCase Cases[] = { { 25, false }, { 25, true }, { 100, true } };
+		constexpr int32 Selections = 500;
+		constexpr int32 Range = 6; // The brawler's movement range.
+
+		for (const FCase& Case : Cases)
+		{
+			FRandomStream Stream(Case.Size);
+			FGridData Grid = MakeRandomGrid(Case.Size, 0.2f, Stream);
+			if (Case.bCosts)
+			{
+				TArray<uint8> Costs;
+				for (int32 Index = 0; Index < Grid.Num(); ++Index) Costs.Add(Stream.RandRange(1, 3));
+				Grid.SetMovementCosts(Costs);
+			}
+			const TBitArray<> Occupied(false, Grid.Num());
+
+			// The movement points a path spends, the first tile being where the unit stands.
+			const auto PathCost = [&Grid](const TArray<FGridCoord>& Path)
+			{
+				int32 Cost = 0;
+				for (int32 i = 1; i < Path.Num(); ++i) Cost += Grid.MovementCost[Grid.ToIndex(Path[i])];
+				return Cost;
+			};
+
+			FGridPathTree Tree;
+			FGridSearchScratch Scratch;
+			TArray<FGridCoord> Path;
+			double TreeSeconds = 0.0;
+			double SearchSeconds = 0.0;
+			int32 Hovers = 0;
+			int32 Mismatches = 0;
+
+			for (int32 Selection = 0; Selection < Selections; ++Selection)
+			{
+				const FGridCoord Unit = RandomFreeCell(Grid, Stream);
+
+				// The tiles the cursor may pass over around the unit.
+				TArray<FGridCoord> Tiles;
+				for (int32 OffsetY = -Range; OffsetY <= Range; ++OffsetY)
+				{
+					for (int32 OffsetX = -Range; OffsetX <= Range; ++OffsetX)
+					{
+						const FGridCoord Tile(Unit.X + OffsetX, Unit.Y + OffsetY);
+						if (Grid.ToIndex(Tile) != INDEX_NONE) Tiles.Add(Tile);
+					}
+				}
+				Hovers += Tiles.Num();
+
+				TArray<int32> TreeCosts;
+				double Begin = FPlatformTime::Seconds();
+				UPathfindingUtilities::GetPathTree(Grid, Grid.ToIndex(Unit), Range, Occupied, Tree);
+				for (const FGridCoord& Tile : Tiles)
+				{
+					TreeCosts.Add(Tree.GetPath(Grid, Grid.ToIndex(Tile), Path) ? PathCost(Path) : INDEX_NONE);
+				}
+				TreeSeconds += FPlatformTime::Seconds() - Begin;
+
+				TArray<int32> SearchCosts;
+				Begin = FPlatformTime::Seconds();
+				for (const FGridCoord& Tile : Tiles)
+				{
+					const TArray<FGridCoord> SearchPath = UPathfindingUtilities::GetPath(Grid, Unit, Tile, Occupied, Scratch);
+					const int32 Cost = SearchPath.Num() > 0 ? PathCost(SearchPath) : INDEX_NONE;
+					SearchCosts.Add(Cost <= Range ? Cost : INDEX_NONE);
+				}
+				SearchSeconds += FPlatformTime::Seconds() - Begin;
+
+				if (TreeCosts != SearchCosts) Mismatches++;
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("Path preview %dx%d%s range %d: path tree %.2f us/hover, A* %.2f us/hover (%d hovers), %d mismatching selections"),
+				Case.Size, Case.Size, Case.bCosts ? TEXT(" with costs") : TEXT(""), Range,
+				TreeSeconds * 1e6 / Hovers, SearchSeconds * 1e6 / Hovers, Hovers, Mismatches);
+		}
+	}
+
+	FAutoConsoleCommand BitboardCommand(
+		TEXT("paa.Bench.Bitboard"),
+		TEXT("Compares BFS movement ranges against bitboard dilation on 25x25, 100x100 and 500x500 grids."),
+		FConsoleCommandDelegate::CreateStatic(&RunBitboard));
+
+	FAutoConsoleCommand BattleRulesCommand(
+		TEXT("paa.Bench.BattleRules"),
+		TEXT("Plays 1000 random battles on the headless battle rules, timing them and validating undo."),
+		FConsoleCommandDelegate::CreateStatic(&RunBattleRules));
+
+	FAutoConsoleCommand HierarchyCommand(
+		TEXT("paa.Bench.Hierarchy"),
+		TEXT("Compares hierarchical (HPA*) against flat A* path queries on 256x256 and 1024x1024 maps."),
+		FConsoleCommandDelegate::CreateStatic(&RunHierarchy));
+
+	FAutoConsoleCommand InfluenceCommand(
+		TEXT("paa.Bench.Influence"),
+		TEXT("Times full builds of the AI's influence map against incremental updates after a move and checks they agree."),
+		FConsoleCommandDelegate::CreateStatic(&RunInfluence));
+
+	FAutoConsoleCommand JumpPointCommand(
+		TEXT("paa.Bench.JumpPoint"),
+		TEXT("Validates Jump Point Search against A* on 25x25 to 1000x1000 random maps and times both."),
+		FConsoleCommandDelegate::CreateStatic(&RunJumpPoint));
+
+	FAutoConsoleCommand LineOfSightCommand(
+		TEXT("paa.Bench.LineOfSight"),
+		TEXT("Times the line-of-sight cache against rays cast on demand on 25x25 and 64x64 maps and checks they agree."),
+		FConsoleCommandDelegate::CreateStatic(&RunLineOfSight));
+
+	FAutoConsoleCommand ObstaclesCommand(
+		TEXT("paa.Bench.Obstacles"),
+		TEXT("Generates 25x25 and 1000x1000 obstacle maps, timing them and validating count, connectivity and determinism."),
+		FConsoleCommandDelegate::CreateStatic(&RunObstacles));
+
+	FAutoConsoleCommand PathPreviewCommand(
+		TEXT("paa.Bench.PathPreview"),
+		TEXT("Compares hover path previews from one path tree per selection against an A* query per hovered tile and checks they agree."),
+		FConsoleCommandDelegate::CreateStatic(&RunPathPreview));
+
+	FAutoConsoleCommand PathfindingCommand(
+		TEXT("paa.Bench.Pathfinding"),
+		TEXT("Compares the heap-based A* against the legacy sorted-list A* on 25x25, 100x100 and 500x500 grids."),
+		FConsoleCommandDelegate::CreateStatic(&RunPathfinding));
+}
+
+#endif
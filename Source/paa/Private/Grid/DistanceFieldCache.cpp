@@ -0,0 +1,119 @@
+#include "Grid/DistanceFieldCache.h"
+
+#include "Grid/GridManager.h"
+#include "Grid/Utils/PathfindingUtilities.h"
+
+void UDistanceFieldCache::Initialize(const AGridManager* InGridManager)
+{
+	GridManager = InGridManager;
+	Reset();
+}
+
+void UDistanceFieldCache::Warm(const TBitArray<>& Occupied)
+{
+	if (!GridManager.IsValid()) return;
+
+	// Build the missing fields up front so the turn itself only performs lookups; every unit stands on a set bit.
+	for (TConstSetBitIterator<> It(Occupied); It; ++It)
+	{
+		FindOrBuild(It.GetIndex(), Occupied);
+	}
+}
+
+int32 UDistanceFieldCache::GetDistance(const FGridCoord& Source, const FGridCoord& Target, const TBitArray<>& Occupied)
+{
+	if (!GridManager.IsValid()) return INDEX_NONE;
+
+	const FGridData& Grid = GridManager->GetGridData();
+	const int32 SourceIndex = Grid.ToIndex(Source);
+	const int32 TargetIndex = Grid.ToIndex(Target);
+
+	if (SourceIndex == INDEX_NONE || TargetIndex == INDEX_NONE) return INDEX_NONE;
+
+	return FindOrBuild(SourceIndex, Occupied)[TargetIndex];
+}
+
+TConstArrayView<FGridCoord> UDistanceFieldCache::GetReachable(const FGridCoord& Source, const int32 Range, const TBitArray<>& Occupied)
+{
+	Reachable.Reset();
+
+	if (!GridManager.IsValid()) return Reachable;
+
+	const FGridData& Grid = GridManager->GetGridData();
+	const int32 SourceIndex = Grid.ToIndex(Source);
+
+	if (SourceIndex == INDEX_NONE) return Reachable;
+
+	const TArray<int32>& Distance = FindOrBuild(SourceIndex, Occupied);
+
+	// No tile farther than Range in Manhattan distance can be within Range steps.
+	for (int32 DY = -Range; DY <= Range; ++DY)
+	{
+		const int32 Y = Source.Y + DY;
+		if (Y < 0 || Y >= Grid.SizeY) continue;
+
+		const int32 Reach = Range - FMath::Abs(DY);
+		const int32 MaxX = FMath::Min(Grid.SizeX - 1, Source.X + Reach);
+		for (int32 X = FMath::Max(0, Source.X - Reach); X <= MaxX; ++X)
+		{
+			const int32 Steps = Distance[Y * Grid.SizeX + X];
+			if (Steps != INDEX_NONE && Steps <= Range) Reachable.Add(FGridCoord(X, Y));
+		}
+	}
+
+	return Reachable;
+}
+
+void UDistanceFieldCache::InvalidateTile(const FGridCoord& Tile)
+{
+	if (!GridManager.IsValid()) return;
+
+	const FGridData& Grid = GridManager->GetGridData();
+	const int32 Index = Grid.ToIndex(Tile);
+
+	if (Index == INDEX_NONE) return;
+
+	int32 Neighbors[4];
+	const int32 NeighborCount = Grid.GetNeighbors(Index, Neighbors);
+
+	for (auto It = Fields.CreateIterator(); It; ++It)
+	{
+		const TArray<int32>& Distance = It.Value();
+
+		// A tile the field never reached, surrounded by tiles it never reached, cannot change it.
+		bool bAffected = Distance[Index] != INDEX_NONE;
+		for (int32 i = 0; i < NeighborCount && !bAffected; ++i)
+		{
+			bAffected = Distance[Neighbors[i]] != INDEX_NONE;
+		}
+
+		if (bAffected)
+		{
+			FreeFields.Add(MoveTemp(It.Value()));
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UDistanceFieldCache::Reset()
+{
+	for (TPair<int32, TArray<int32>>& Pair : Fields)
+	{
+		FreeFields.Add(MoveTemp(Pair.Value));
+	}
+	Fields.Reset();
+}
+
+const TArray<int32>& UDistanceFieldCache::FindOrBuild(const int32 Source, const TBitArray<>& Occupied)
+{
+	if (const TArray<int32>* Cached = Fields.Find(Source))
+	{
+		return *Cached;
+	}
+
+	// Reuse the storage of a dropped field when one is available.
+	TArray<int32>& Distance = Fields.Add(Source, FreeFields.Num() > 0 ? FreeFields.Pop(EAllowShrinking::No) : TArray<int32>());
+	UPathfindingUtilities::GetDistanceField(GridManager->GetGridData(), Source, Occupied, Distance, Queue);
+
+	return Distance;
+}
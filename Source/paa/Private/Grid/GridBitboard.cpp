@@ -0,0 +1,214 @@
+#include "Grid/GridBitboard.h"
+
+namespace
+{
+	/**
+	 * Reads up to 64 consecutive bits of a bit array.
+	 * @param Data - The 32-bit words of the bit array.
+	 * @param Start - The index of the first bit.
+	 * @param Count - The number of bits, between 1 and 64; Start + Count must not exceed the array.
+	 * @return The bits, the first one in bit 0.
+	 */
+	uint64 ReadBits(const uint32* Data, const int32 Start, const int32 Count)
+	{
+		const int32 Shift = Start & 31;
+		int32 Word = Start >> 5;
+
+		uint64 Value = uint64(Data[Word]) >> Shift;
+		for (int32 Read = 32 - Shift; Read < Count; Read += 32)
+		{
+			Value |= uint64(Data[++Word]) << Read;
+		}
+
+		return Count == 64 ? Value : Value & ((uint64(1) << Count) - 1);
+	}
+
+	/** @return A word with the bits [From, To] set, both within 0-63. */
+	uint64 RunMask(const int32 From, const int32 To)
+	{
+		const uint64 Upper = To == 63 ? ~uint64(0) : (uint64(1) << (To + 1)) - 1;
+		return Upper & ~((uint64(1) << From) - 1);
+	}
+}
+
+void FGridBitboard::Init(const int32 InSizeX, const int32 InSizeY)
+{
+	SizeX = InSizeX;
+	SizeY = InSizeY;
+	WordsPerRow = (SizeX + 63) / 64;
+
+	// Boards are re-initialized for every query, so keep the allocation when the size does not change.
+	Words.SetNumUninitialized(WordsPerRow * SizeY);
+	Reset();
+}
+
+void FGridBitboard::Reset()
+{
+	FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+}
+
+void FGridBitboard::OrRowBits(const int32 Row, int32 FirstX, uint64 Bits)
+{
+	if (Row < 0 || Row >= SizeY || FirstX >= SizeX || FirstX <= -64) return;
+
+	// Clip the run to the grid: drop the bits left of column 0, then those past the last column.
+	if (FirstX < 0)
+	{
+		Bits >>= -FirstX;
+		FirstX = 0;
+	}
+	if (SizeX - FirstX < 64) Bits &= (uint64(1) << (SizeX - FirstX)) - 1;
+
+	// The run straddles at most two words of the row.
+	uint64* RowWords = &Words[Row * WordsPerRow];
+	const int32 Shift = FirstX & 63;
+	RowWords[FirstX >> 6] |= Bits << Shift;
+	if (Shift != 0 && (FirstX >> 6) + 1 < WordsPerRow) RowWords[(FirstX >> 6) + 1] |= Bits >> (64 - Shift);
+}
+
+void FGridBitboard::SetWalkable(const FGridData& Grid, const TBitArray<>& Occupied)
+{
+	if (SizeX != Grid.SizeX || SizeY != Grid.SizeY) Init(Grid.SizeX, Grid.SizeY);
+
+	const uint32* Obstacles = Grid.Obstacles.GetData();
+	const uint32* Units = Occupied.GetData();
+
+	// Each row is read straight out of the per-cell masks, 64 cells at a time.
+	for (int32 Row = 0; Row < SizeY; ++Row)
+	{
+		for (int32 Word = 0; Word < WordsPerRow; ++Word)
+		{
+			const int32 Start = Row * SizeX + Word * 64;
+			const int32 Count = FMath::Min(64, SizeX - Word * 64);
+			const uint64 Inside = Count == 64 ? ~uint64(0) : (uint64(1) << Count) - 1;
+
+			Words[Row * WordsPerRow + Word] = ~(ReadBits(Obstacles, Start, Count) | ReadBits(Units, Start, Count)) & Inside;
+		}
+	}
+}
+
+void FGridBitboard::SetDiamond(const FGridCoord& Center, const int32 Range)
+{
+	Reset();
+
+	for (int32 Row = FMath::Max(0, Center.Y - Range); Row <= FMath::Min(SizeY - 1, Center.Y + Range); ++Row)
+	{
+		const int32 Reach = Range - FMath::Abs(Row - Center.Y);
+		const int32 From = FMath::Max(0, Center.X - Reach);
+		const int32 To = FMath::Min(SizeX - 1, Center.X + Reach);
+
+		// Fill the run [From, To] of the row, word by word.
+		for (int32 Word = From >> 6; Word <= To >> 6 && From <= To; ++Word)
+		{
+			const int32 First = FMath::Max(From, Word * 64) - Word * 64;
+			const int32 Last = FMath::Min(To, Word * 64 + 63) - Word * 64;
+			Words[Row * WordsPerRow + Word] = RunMask(First, Last);
+		}
+	}
+}
+
+void FGridBitboard::Dilate(const FGridBitboard& Walkable, const int32 Steps)
+{
+	check(Walkable.SizeX == SizeX && Walkable.SizeY == SizeY);
+
+	int32 FirstRow, LastRow;
+	GetRowBounds(FirstRow, LastRow);
+	if (FirstRow > LastRow) return;
+
+	// The old contents of the row above and of the current row; rows are updated in place, top to bottom.
+	RowScratch.SetNumUninitialized(WordsPerRow * 2);
+	uint64* Above = RowScratch.GetData();
+	uint64* Current = Above + WordsPerRow;
+
+	for (int32 Step = 0; Step < Steps; ++Step)
+	{
+		// A step can only reach one row beyond the rows already in the set.
+		FirstRow = FMath::Max(0, FirstRow - 1);
+		LastRow = FMath::Min(SizeY - 1, LastRow + 1);
+		bool bGrew = false;
+
+		if (FirstRow > 0) FMemory::Memcpy(Above, &Words[(FirstRow - 1) * WordsPerRow], WordsPerRow * sizeof(uint64));
+		else FMemory::Memzero(Above, WordsPerRow * sizeof(uint64));
+
+		for (int32 Row = FirstRow; Row <= LastRow; ++Row)
+		{
+			uint64* RowWords = &Words[Row * WordsPerRow];
+			const uint64* Below = Row + 1 < SizeY ? RowWords + WordsPerRow : nullptr; // Not updated yet.
+			const uint64* Walk = &Walkable.Words[Row * WordsPerRow];
+			FMemory::Memcpy(Current, RowWords, WordsPerRow * sizeof(uint64));
+
+			for (int32 Word = 0; Word < WordsPerRow; ++Word)
+			{
+				const uint64 Cells = Current[Word];
+
+				// East and west neighbours, carrying the bits that cross a word boundary.
+				uint64 Neighbors = Cells << 1 | Cells >> 1 | Above[Word];
+				if (Word > 0) Neighbors |= Current[Word - 1] >> 63;
+				if (Word + 1 < WordsPerRow) Neighbors |= Current[Word + 1] << 63;
+				if (Below) Neighbors |= Below[Word];
+
+				const uint64 Grown = Cells | (Neighbors & Walk[Word]);
+				bGrew |= Grown != Cells;
+				RowWords[Word] = Grown;
+			}
+
+			Swap(Above, Current);
+		}
+
+		if (!bGrew) break;
+	}
+}
+
+void FGridBitboard::And(const FGridBitboard& Other)
+{
+	check(Other.Words.Num() == Words.Num());
+	for (int32 Index = 0; Index < Words.Num(); ++Index) Words[Index] &= Other.Words[Index];
+}
+
+void FGridBitboard::Or(const FGridBitboard& Other)
+{
+	check(Other.Words.Num() == Words.Num());
+	for (int32 Index = 0; Index < Words.Num(); ++Index) Words[Index] |= Other.Words[Index];
+}
+
+void FGridBitboard::AndNot(const FGridBitboard& Other)
+{
+	check(Other.Words.Num() == Words.Num());
+	for (int32 Index = 0; Index < Words.Num(); ++Index) Words[Index] &= ~Other.Words[Index];
+}
+
+bool FGridBitboard::Intersects(const FGridBitboard& Other) const
+{
+	check(Other.Words.Num() == Words.Num());
+
+	uint64 Common = 0;
+	for (int32 Index = 0; Index < Words.Num(); ++Index) Common |= Words[Index] & Other.Words[Index];
+
+	return Common != 0;
+}
+
+int32 FGridBitboard::CountSetBits() const
+{
+	int32 Count = 0;
+	for (const uint64 Word : Words) Count += int32(FPlatformMath::CountBits(Word));
+
+	return Count;
+}
+
+void FGridBitboard::GetRowBounds(int32& OutFirstRow, int32& OutLastRow) const
+{
+	OutFirstRow = SizeY;
+	OutLastRow = -1;
+
+	for (int32 Row = 0; Row < SizeY; ++Row)
+	{
+		for (int32 Word = 0; Word < WordsPerRow; ++Word)
+		{
+			if (Words[Row * WordsPerRow + Word] == 0) continue;
+
+			OutFirstRow = FMath::Min(OutFirstRow, Row);
+			OutLastRow = Row;
+			break;
+		}
+	}
+}
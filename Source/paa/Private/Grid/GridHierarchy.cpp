@@ -0,0 +1,416 @@
+#include "Grid/GridHierarchy.h"
+
+#include "Algo/Reverse.h"
+
+namespace
+{
+	// Entrances at least this long get a transition at each end instead of one in the middle, as in the HPA* paper,
+	// so wide openings do not force paths through their center.
+	constexpr int32 LongEntranceLength = 6;
+}
+
+void FGridHierarchy::Build(const FGridData& Grid, const int32 InClusterSize)
+{
+	check(InClusterSize > 0);
+
+	ClusterSize = InClusterSize;
+	SectorsX = FMath::DivideAndRoundUp(Grid.SizeX, ClusterSize);
+	const int32 SectorsY = FMath::DivideAndRoundUp(Grid.SizeY, ClusterSize);
+
+	Blocked = Grid.Obstacles;
+	Occupancy.Init(false, Grid.Num());
+	NodeSlot.Init(INDEX_NONE, Grid.Num());
+	DirtySectors.Init(false, SectorsX * SectorsY);
+	DirtyList.Reset();
+
+	Sectors.Reset(SectorsX * SectorsY);
+	for (int32 SY = 0; SY < SectorsY; ++SY)
+	{
+		for (int32 SX = 0; SX < SectorsX; ++SX)
+		{
+			FSector& Sector = Sectors.AddDefaulted_GetRef();
+			Sector.MinX = SX * ClusterSize;
+			Sector.MinY = SY * ClusterSize;
+			Sector.MaxX = FMath::Min(Grid.SizeX, Sector.MinX + ClusterSize) - 1;
+			Sector.MaxY = FMath::Min(Grid.SizeY, Sector.MinY + ClusterSize) - 1;
+		}
+	}
+
+	LocalDistance.SetNumUninitialized(ClusterSize * ClusterSize);
+	LocalParent.SetNumUninitialized(ClusterSize * ClusterSize);
+	LocalQueue.SetNumUninitialized(ClusterSize * ClusterSize);
+
+	for (int32 Sector = 0; Sector < Sectors.Num(); ++Sector)
+	{
+		RebuildSector(Grid, Sector);
+	}
+}
+
+void FGridHierarchy::Reset()
+{
+	ClusterSize = 0;
+	SectorsX = 0;
+	Sectors.Reset();
+	NodeSlot.Reset();
+	Blocked.Reset();
+	Occupancy.Reset();
+	DirtySectors.Reset();
+	DirtyList.Reset();
+}
+
+int32 FGridHierarchy::Sync(const FGridData& Grid, const TBitArray<>& Occupied)
+{
+	check(IsBuilt() && Occupied.Num() == Occupancy.Num());
+
+	// Compare the masks 32 cells at a time; only the words that differ are looked at cell by cell.
+	const uint32* New = Occupied.GetData();
+	const uint32* Old = Occupancy.GetData();
+	const int32 NumWords = FMath::DivideAndRoundUp(Occupied.Num(), 32);
+
+	for (int32 Word = 0; Word < NumWords; ++Word)
+	{
+		for (uint32 Changed = New[Word] ^ Old[Word]; Changed != 0; Changed &= Changed - 1)
+		{
+			const int32 Cell = Word * 32 + int32(FMath::CountTrailingZeros(Changed));
+			if (Cell >= Grid.Num()) break;
+
+			Blocked[Cell] = Grid.IsObstacle(Cell) || Occupied[Cell];
+
+			// The cell's own sector, plus the sector across every sector edge the cell lies on.
+			const int32 Sector = GetSectorOf(Grid, Cell);
+			const FSector& Bounds = Sectors[Sector];
+			const int32 X = Cell % Grid.SizeX;
+			const int32 Y = Cell / Grid.SizeX;
+
+			int32 Affected[5];
+			int32 NumAffected = 0;
+			Affected[NumAffected++] = Sector;
+			if (X == Bounds.MinX && X > 0) Affected[NumAffected++] = Sector - 1;
+			if (X == Bounds.MaxX && X < Grid.SizeX - 1) Affected[NumAffected++] = Sector + 1;
+			if (Y == Bounds.MinY && Y > 0) Affected[NumAffected++] = Sector - SectorsX;
+			if (Y == Bounds.MaxY && Y < Grid.SizeY - 1) Affected[NumAffected++] = Sector + SectorsX;
+
+			for (int32 i = 0; i < NumAffected; ++i)
+			{
+				if (DirtySectors[Affected[i]]) continue;
+
+				DirtySectors[Affected[i]] = true;
+				DirtyList.Add(Affected[i]);
+			}
+		}
+	}
+
+	Occupancy = Occupied;
+
+	const int32 NumRebuilt = DirtyList.Num();
+	for (const int32 Sector : DirtyList)
+	{
+		RebuildSector(Grid, Sector);
+		DirtySectors[Sector] = false;
+	}
+	DirtyList.Reset();
+
+	return NumRebuilt;
+}
+
+TArray<FGridCoord> FGridHierarchy::FindPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile,
+	const TBitArray<>& Occupied, FGridSearchScratch& Scratch)
+{
+	TArray<FGridCoord> Path;
+	if (!TryFindPath(Grid, StartTile, EndTile, Occupied, Scratch, Path))
+	{
+		return UPathfindingUtilities::GetPath(Grid, StartTile, EndTile, Occupied, Scratch);
+	}
+
+	return Path;
+}
+
+bool FGridHierarchy::TryFindPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile,
+	const TBitArray<>& Occupied, FGridSearchScratch& Scratch, TArray<FGridCoord>& OutPath)
+{
+	const int32 Start = Grid.ToIndex(StartTile);
+	const int32 End = Grid.ToIndex(EndTile);
+
+	// Invalid queries and nearby targets are left to the flat search, which also reports what is wrong with the query.
+	// So are grids with movement costs: sector distances are counted in steps.
+	if (Start == INDEX_NONE || End == INDEX_NONE || Occupied.Num() != Occupancy.Num() || !Grid.IsUniformCost() ||
+		Grid.IsObstacle(Start) || Grid.IsObstacle(End) || Occupied[End] ||
+		StartTile.Distance(EndTile) <= ClusterSize || GetSectorOf(Grid, Start) == GetSectorOf(Grid, End))
+	{
+		return false;
+	}
+
+	Sync(Grid, Occupied);
+
+	TArray<int32> Nodes;
+	if (!FindAbstractPath(Grid, Start, End, Scratch, Nodes)) return false;
+
+	RefinePath(Grid, Nodes, OutPath);
+
+	return true;
+}
+
+bool FGridHierarchy::FindAbstractPath(const FGridData& Grid, const int32 Start, const int32 End, FGridSearchScratch& Scratch, TArray<int32>& OutNodes)
+{
+	OutNodes.Reset();
+
+	const FSector& StartSector = Sectors[GetSectorOf(Grid, Start)];
+	const int32 EndSectorIndex = GetSectorOf(Grid, End);
+	const FSector& EndSector = Sectors[EndSectorIndex];
+
+	// Link the start and the end to the nodes of their sectors.
+	SearchSector(Grid, StartSector, Start);
+	StartLinks.Reset();
+	for (const int32 Node : StartSector.Nodes)
+	{
+		const int32 Steps = LocalDistance[ToLocal(Grid, StartSector, Node)];
+		if (Steps != INDEX_NONE) StartLinks.Add({ Node, Steps });
+	}
+
+	SearchSector(Grid, EndSector, End);
+	EndCost.SetNumUninitialized(EndSector.Nodes.Num());
+	for (int32 Slot = 0; Slot < EndSector.Nodes.Num(); ++Slot)
+	{
+		EndCost[Slot] = LocalDistance[ToLocal(Grid, EndSector, EndSector.Nodes[Slot])];
+	}
+
+	// A* over the nodes, keyed by cell like the flat search so the same scratch serves both.
+	Scratch.Begin(Grid.Num());
+	const FGridSearchScratch::FOpenNodePredicate Predicate;
+	const FGridCoord EndTile = Grid.ToCoord(End);
+
+	auto Relax = [&](const int32 From, const int32 To, const int32 Cost)
+	{
+		if (Scratch.IsClosed(To)) return;
+
+		const int32 G = Scratch.GScore[From] + Cost;
+		if (Scratch.IsOpened(To) && G >= Scratch.GScore[To]) return;
+
+		Scratch.Reach(To, G, From, 0);
+		const int32 H = Grid.ToCoord(To).Distance(EndTile);
+		Scratch.Heap.HeapPush({ G + H, H, To }, Predicate);
+	};
+
+	Scratch.Reach(Start, 0, INDEX_NONE, 0);
+	Scratch.Heap.HeapPush({ Grid.ToCoord(Start).Distance(EndTile), Grid.ToCoord(Start).Distance(EndTile), Start }, Predicate);
+
+	while (Scratch.Heap.Num() > 0)
+	{
+		FGridSearchScratch::FOpenNode Open;
+		Scratch.Heap.HeapPop(Open, Predicate, EAllowShrinking::No);
+
+		const int32 Current = Open.Index;
+		if (Scratch.IsClosed(Current) || Open.F - Open.H != Scratch.GScore[Current]) continue;
+		Scratch.Close(Current);
+
+		if (Current == End)
+		{
+			for (int32 Node = End; Node != INDEX_NONE; Node = Scratch.Parent[Node])
+			{
+				OutNodes.Add(Node);
+			}
+			Algo::Reverse(OutNodes);
+			return true;
+		}
+
+		const int32 Slot = NodeSlot[Current];
+		const int32 SectorIndex = GetSectorOf(Grid, Current);
+		const FSector& Sector = Sectors[SectorIndex];
+
+		// Hops inside the sector.
+		if (Current == Start)
+		{
+			for (const TPair<int32, int32>& Link : StartLinks) Relax(Current, Link.Key, Link.Value);
+		}
+		else if (Slot != INDEX_NONE)
+		{
+			const int32 NumNodes = Sector.Nodes.Num();
+			for (int32 Other = 0; Other < NumNodes; ++Other)
+			{
+				const int32 Steps = Sector.Distances[Slot * NumNodes + Other];
+				if (Other != Slot && Steps != INDEX_NONE) Relax(Current, Sector.Nodes[Other], Steps);
+			}
+		}
+
+		if (Slot == INDEX_NONE) continue;
+
+		// Steps across a border into a facing node.
+		int32 Neighbors[4];
+		const int32 NeighborCount = Grid.GetNeighbors(Current, Neighbors);
+		for (int32 i = 0; i < NeighborCount; ++i)
+		{
+			if (NodeSlot[Neighbors[i]] != INDEX_NONE && GetSectorOf(Grid, Neighbors[i]) != SectorIndex) Relax(Current, Neighbors[i], 1);
+		}
+
+		// The last hop, from a node of the end sector.
+		if (SectorIndex == EndSectorIndex && EndCost[Slot] != INDEX_NONE) Relax(Current, End, EndCost[Slot]);
+	}
+
+	return false;
+}
+
+void FGridHierarchy::RefinePath(const FGridData& Grid, TConstArrayView<int32> Nodes, TArray<FGridCoord>& OutPath)
+{
+	OutPath.Reset();
+	if (Nodes.Num() == 0) return;
+
+	OutPath.Add(Grid.ToCoord(Nodes[0]));
+
+	TArray<int32> Segment;
+	for (int32 Hop = 1; Hop < Nodes.Num(); ++Hop)
+	{
+		const int32 From = Nodes[Hop - 1];
+		const int32 To = Nodes[Hop];
+		const int32 SectorIndex = GetSectorOf(Grid, From);
+
+		// A border crossing is a single step.
+		if (GetSectorOf(Grid, To) != SectorIndex)
+		{
+			OutPath.Add(Grid.ToCoord(To));
+			continue;
+		}
+
+		// Anything else is a walk inside one sector; search it again and follow the parents back.
+		const FSector& Sector = Sectors[SectorIndex];
+		SearchSector(Grid, Sector, From);
+
+		Segment.Reset();
+		for (int32 Local = ToLocal(Grid, Sector, To); Local != INDEX_NONE && ToCell(Grid, Sector, Local) != From; Local = LocalParent[Local])
+		{
+			Segment.Add(ToCell(Grid, Sector, Local));
+		}
+
+		for (int32 i = Segment.Num() - 1; i >= 0; --i)
+		{
+			OutPath.Add(Grid.ToCoord(Segment[i]));
+		}
+	}
+}
+
+int32 FGridHierarchy::GetNumNodes() const
+{
+	int32 NumNodes = 0;
+	for (const FSector& Sector : Sectors) NumNodes += Sector.Nodes.Num();
+
+	return NumNodes;
+}
+
+int32 FGridHierarchy::GetSectorOf(const FGridData& Grid, const int32 Cell) const
+{
+	return (Cell / Grid.SizeX / ClusterSize) * SectorsX + (Cell % Grid.SizeX) / ClusterSize;
+}
+
+void FGridHierarchy::RebuildSector(const FGridData& Grid, const int32 SectorIndex)
+{
+	FSector& Sector = Sectors[SectorIndex];
+
+	for (const int32 Node : Sector.Nodes) NodeSlot[Node] = INDEX_NONE;
+	Sector.Nodes.Reset();
+
+	const int32 Width = Sector.MaxX - Sector.MinX + 1;
+	const int32 Height = Sector.MaxY - Sector.MinY + 1;
+	const int32 TopLeft = Sector.MinY * Grid.SizeX + Sector.MinX;
+
+	// Both sectors of a border scan the same pairs of cells, so they always agree on where the transitions are.
+	if (Sector.MinY > 0) AddBorderNodes(Grid, Sector, TopLeft, 1, Width, -Grid.SizeX);
+	if (Sector.MaxY < Grid.SizeY - 1) AddBorderNodes(Grid, Sector, TopLeft + (Height - 1) * Grid.SizeX, 1, Width, Grid.SizeX);
+	if (Sector.MinX > 0) AddBorderNodes(Grid, Sector, TopLeft, Grid.SizeX, Height, -1);
+	if (Sector.MaxX < Grid.SizeX - 1) AddBorderNodes(Grid, Sector, TopLeft + Width - 1, Grid.SizeX, Height, 1);
+
+	// One search per node gives its row of distances.
+	const int32 NumNodes = Sector.Nodes.Num();
+	Sector.Distances.SetNumUninitialized(NumNodes * NumNodes);
+
+	for (int32 Slot = 0; Slot < NumNodes; ++Slot)
+	{
+		SearchSector(Grid, Sector, Sector.Nodes[Slot]);
+		for (int32 Other = 0; Other < NumNodes; ++Other)
+		{
+			Sector.Distances[Slot * NumNodes + Other] = LocalDistance[ToLocal(Grid, Sector, Sector.Nodes[Other])];
+		}
+	}
+}
+
+void FGridHierarchy::AddBorderNodes(const FGridData& Grid, FSector& Sector, const int32 First, const int32 Stride,
+	const int32 Length, const int32 Across)
+{
+	auto AddNode = [this, &Sector](const int32 Cell)
+	{
+		// A corner cell can be a transition of two borders.
+		if (NodeSlot[Cell] != INDEX_NONE) return;
+
+		NodeSlot[Cell] = Sector.Nodes.Num();
+		Sector.Nodes.Add(Cell);
+	};
+
+	int32 RunStart = INDEX_NONE;
+	for (int32 Step = 0; Step <= Length; ++Step)
+	{
+		const int32 Cell = First + Step * Stride;
+		const bool bOpen = Step < Length && !Blocked[Cell] && !Blocked[Cell + Across];
+
+		if (bOpen)
+		{
+			if (RunStart == INDEX_NONE) RunStart = Step;
+			continue;
+		}
+
+		if (RunStart == INDEX_NONE) continue;
+
+		// Close the run [RunStart, Step - 1].
+		const int32 RunEnd = Step - 1;
+		if (RunEnd - RunStart + 1 >= LongEntranceLength)
+		{
+			AddNode(First + RunStart * Stride);
+			AddNode(First + RunEnd * Stride);
+		}
+		else
+		{
+			AddNode(First + (RunStart + RunEnd) / 2 * Stride);
+		}
+
+		RunStart = INDEX_NONE;
+	}
+}
+
+void FGridHierarchy::SearchSector(const FGridData& Grid, const FSector& Sector, const int32 Source)
+{
+	const int32 Width = Sector.MaxX - Sector.MinX + 1;
+	const int32 NumLocal = Width * (Sector.MaxY - Sector.MinY + 1);
+
+	for (int32 Local = 0; Local < NumLocal; ++Local) LocalDistance[Local] = INDEX_NONE;
+
+	const int32 SourceLocal = ToLocal(Grid, Sector, Source);
+	LocalDistance[SourceLocal] = 0;
+	LocalParent[SourceLocal] = INDEX_NONE;
+
+	int32 Head = 0;
+	int32 Tail = 0;
+	LocalQueue[Tail++] = SourceLocal;
+
+	while (Head < Tail)
+	{
+		const int32 Current = LocalQueue[Head++];
+		const int32 X = Current % Width;
+		const int32 Y = Current / Width;
+		const int32 Cell = ToCell(Grid, Sector, Current);
+
+		// North, south, west, east, as in FGridData::GetNeighbors, without leaving the sector.
+		const int32 Candidates[4][2] = {
+			{ Y > 0 ? Current - Width : INDEX_NONE, Cell - Grid.SizeX },
+			{ Current + Width < NumLocal ? Current + Width : INDEX_NONE, Cell + Grid.SizeX },
+			{ X > 0 ? Current - 1 : INDEX_NONE, Cell - 1 },
+			{ X < Width - 1 ? Current + 1 : INDEX_NONE, Cell + 1 }
+		};
+
+		for (const int32 (&Candidate)[2] : Candidates)
+		{
+			const int32 Next = Candidate[0];
+			if (Next == INDEX_NONE || LocalDistance[Next] != INDEX_NONE || Blocked[Candidate[1]]) continue;
+
+			LocalDistance[Next] = LocalDistance[Current] + 1;
+			LocalParent[Next] = Current;
+			LocalQueue[Tail++] = Next;
+		}
+	}
+}
@@ -3,35 +3,141 @@
 #include "Grid/Utils/GridUtilities.h"
 #include "Grid/Utils/ObstaclesUtilities.h"
 #include "Grid/Utils/PathfindingUtilities.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ConstructorHelpers.h"
+
+namespace
+{
+	/**
+	 * Layout of the per-instance custom data read by the instanced tile material. The slots stand in for the
+	 * parameters of M_GridTile: BaseColor (vector), TextureIndex and bIsObstacle (scalars).
+	 */
+	enum ETileCustomData : int32
+	{
+		BaseColorR,
+		BaseColorG,
+		BaseColorB,
+		TextureIndex,
+		IsObstacle,
+		Count
+	};
+}
 
 AGridManager::AGridManager()
 {
-	// Disable ticking as grid systems are static after generation.
-	PrimaryActorTick.bCanEverTick = false;
+	// Tick only on frames with pending tile color changes; the grid is otherwise static after generation.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	
 	// Create a root component for the grid system.
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("GridSystem"));
+
+	// Create the instanced mesh holding every tile in instanced mode.
+	TileInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("TileInstances"));
+	TileInstances->SetupAttachment(RootComponent);
+	TileInstances->NumCustomDataFloats = ETileCustomData::Count;
+	TileInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision); // Tiles are picked analytically, see PickTile.
+
+	// Tiles are the same engine plane the tile actors use.
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> PlaneMesh(TEXT("/Engine/BasicShapes/Plane"));
+	if (PlaneMesh.Succeeded())
+	{
+		TileInstances->SetStaticMesh(PlaneMesh.Object);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to set PlaneMesh asset for TileInstances"));
+	}
 }
 
-void AGridManager::Initialize(AStrategyGameMode* GameMode)
+void AGridManager::Initialize(AStrategyGameMode* InGameMode)
 {
+	GameMode = InGameMode;
+	
 	// Bind to the obstacle percentage change event.
 	GameMode->OnObstaclePercentageSet.RemoveDynamic(this, &AGridManager::SetObstaclePercentage);
 	GameMode->OnObstaclePercentageSet.AddDynamic(this, &AGridManager::SetObstaclePercentage);
+
+	// Create the distance field cache used during battle.
+	DistanceFields = NewObject<UDistanceFieldCache>(this);
+	DistanceFields->Initialize(this);
 }
 
 void AGridManager::GenerateGrid()
 {
-	// Clear any previously stored tiles.
-	if (TileMap.Num() > 0) TileMap.Empty();
+	// Destroy any previously spawned tiles and reset the grid model.
+	for (const TWeakObjectPtr<ATile>& Tile : Grid.Tiles)
+	{
+		if (Tile.IsValid()) Tile->Destroy();
+	}
+	TileInstances->ClearInstances();
+	Grid.Init(GridSizeX, GridSizeY);
+	if (DistanceFields) DistanceFields->Reset();
+	Hierarchy.Reset();
+
+	// Every new tile starts white with nothing pending.
+	DisplayedColors.Init(FLinearColor::White, Grid.Num());
+	RequestedColors.Init(FLinearColor::White, Grid.Num());
+	BaseColors.Init(FLinearColor::White, Grid.Num());
+	DirtyMask.Init(false, Grid.Num());
+	DirtyTiles.Reset();
+	HighlightedTiles.Reset();
+	HighlightMask.Init(false, Grid.Num());
+	PreviewTiles.Reset();
+	PreviewMask.Init(false, Grid.Num());
+	SetActorTickEnabled(false);
+
+	// Texture variants are drawn in flat index order from the match's stream, whatever the render mode.
+	TArray<int32> Variants;
+	Variants.SetNumUninitialized(Grid.Num());
+	FMatchRng& VariantStream = GameMode->GetRandomStream(ERandomStream::TileVariants);
+	for (int32& Variant : Variants)
+	{
+		Variant = VariantStream.RandRange(0, 2);
+	}
+
+	// Instancing needs a material that reads the per-instance custom data; M_GridTile reads material parameters.
+	bUseInstances = RenderMode == EGridRenderMode::Instanced && InstancedTileMaterial && InstancedTileMaterial->GetCachedExpressionData().bHasPerInstanceCustomData;
+	if (RenderMode == EGridRenderMode::Instanced && !bUseInstances)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No instanced tile material reading per-instance custom data set, falling back to tile actors"));
+	}
+
+	if (bUseInstances)
+	{
+		// One instance per cell, added in flat index order so that instance index == cell index.
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(Grid.Num());
+		
+		const FVector Scale(TileSize / 100.f, TileSize / 100.f, 1.f); // The plane mesh is 100x100 units.
+		for (int32 Index = 0; Index < Grid.Num(); ++Index)
+		{
+			const FGridCoord Coord = Grid.ToCoord(Index);
+			Transforms.Add(FTransform(FRotator::ZeroRotator, UGridUtilities::GetCoordinate(Coord.X, Coord.Y, GridSizeX, GridSizeY, TileSize), Scale));
+		}
+
+		TileInstances->SetMaterial(0, InstancedTileMaterial);
+		TileInstances->SetNumCustomDataFloats(ETileCustomData::Count);
+		TileInstances->AddInstances(Transforms, false, false); // In the grid actor's space, like the tile actors.
+
+		// Initial visual state: white, the drawn texture variant, walkable; one write per instance.
+		float CustomData[ETileCustomData::Count] = { 1.f, 1.f, 1.f, 0.f, 0.f };
+		for (int32 Index = 0; Index < Grid.Num(); ++Index)
+		{
+			CustomData[ETileCustomData::TextureIndex] = Variants[Index];
+			TileInstances->SetCustomData(Index, MakeArrayView(CustomData));
+		}
+		TileInstances->MarkRenderStateDirty();
+
+		return;
+	}
 	
 	// Loop through grid dimensions.
 	for (int X = 0; X < GridSizeX; X++)
 	{
 		for (int Y = 0; Y < GridSizeY; Y++)
 		{
-			// Create a coordinate name (e.g., "A1", "B3").
-			const FString Name = UGridUtilities::GetCoordinateName(X, Y, GridSizeX, GridSizeY);
 			// Get the corresponding world location.
 			const FVector Location = UGridUtilities::GetCoordinate(X, Y, GridSizeX, GridSizeY, TileSize);
 
@@ -39,11 +145,16 @@ void AGridManager::GenerateGrid()
 			ATile* Tile = GetWorld()->SpawnActor<ATile>(Location, FRotator(0, 0, 0));
 			// Set the tile as a child of this actor.
 			Tile->AttachToActor(this, FAttachmentTransformRules::KeepRelativeTransform);
-			// Set the tile's label in the editor for identification.
-			Tile->SetActorLabel(Name);
+#if WITH_EDITOR
+			// Set the tile's label in the editor for identification (e.g., "A1", "B3").
+			Tile->SetActorLabel(UGridUtilities::GetCoordinateName(X, Y, GridSizeX, GridSizeY));
+#endif
 			
-			// Add the tile to the map with its coordinate name.
-			TileMap.Add(Name, Tile);
+			// Store the tile at its flat index.
+			const int32 Index = Grid.ToIndex(FGridCoord(X, Y));
+			Grid.Tiles[Index] = Tile;
+			Tile->SetTextureIndex(Variants[Index]);
+			Tile->UpdateMaterial();
 		}
 	}
 }
@@ -51,56 +162,246 @@ void AGridManager::GenerateGrid()
 void AGridManager::GenerateObstacles()
 {
 	// Generate obstacles on the grid using the specified obstacle percentage.
-	UObstaclesUtilities::GenerateObstacles(TileMap, GridSizeX, GridSizeY, TileSize, ObstaclePercentage);
+	const int32 Seed = ObstacleSeed != 0 ? ObstacleSeed : int32(GameMode->GetRandomStream(ERandomStream::Obstacles).Next() & MAX_int32);
+	UObstaclesUtilities::GenerateObstacles(Grid, ObstaclePercentage, Seed);
+	UE_LOG(LogTemp, Display, TEXT("Generated obstacles with seed %d"), Seed);
+
+	// Tile actors are synced by the generator; instances are synced here in one batch.
+	if (bUseInstances) SyncInstanceObstacles();
+
+	// Every cached distance field and the sector graph were computed against the old walls.
+	if (DistanceFields) DistanceFields->Reset();
+	RebuildHierarchy();
 }
 
-FVector AGridManager::GridToWorld(const FString& TileName) const
+void AGridManager::SetObstacles(const TBitArray<>& Obstacles)
+{
+	if (Obstacles.Num() != Grid.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SetObstacles: the layout has %d cells, the grid %d"), Obstacles.Num(), Grid.Num());
+		return;
+	}
+
+	Grid.Obstacles = Obstacles;
+
+	// Push the layout to the tiles and drop the fields computed against the old walls, as GenerateObstacles does.
+	if (bUseInstances) SyncInstanceObstacles();
+	else UObstaclesUtilities::SyncTiles(Grid);
+
+	if (DistanceFields) DistanceFields->Reset();
+	RebuildHierarchy();
+}
+
+void AGridManager::SetMovementCosts(const TArray<uint8>& Costs)
+{
+	if (Costs.Num() != 0 && Costs.Num() != Grid.Num())
+	{
+		UE_LOG(LogTemp, Error, TEXT("SetMovementCosts: %d costs for a grid of %d cells"), Costs.Num(), Grid.Num());
+		return;
+	}
+
+	Grid.SetMovementCosts(Costs);
+
+	// Cached fields hold movement points, so they all change.
+	if (DistanceFields) DistanceFields->Reset();
+}
+
+void AGridManager::RebuildHierarchy()
+{
+	if (!bUseHierarchicalPathfinding)
+	{
+		Hierarchy.Reset();
+		return;
+	}
+
+	const double Begin = FPlatformTime::Seconds();
+	Hierarchy.Build(Grid, FMath::Max(4, HierarchyClusterSize));
+	UE_LOG(LogTemp, Display, TEXT("Built the path hierarchy: %d nodes in %.2f ms"), Hierarchy.GetNumNodes(), (FPlatformTime::Seconds() - Begin) * 1000.0);
+}
+
+FVector AGridManager::GridToWorld(const FGridCoord& Coord) const
 {
 	// Convert a grid coordinate to a world position.
-	return UGridUtilities::GridToWorld(TileName, GridSizeX, GridSizeY, TileSize);
+	return UGridUtilities::GridToWorld(Coord, GridSizeX, GridSizeY, TileSize);
 }
 
-FString AGridManager::WorldToGrid(const FVector& TilePosition) const
+FGridCoord AGridManager::WorldToGrid(const FVector& TilePosition) const
 {
 	// Convert a world position to a grid coordinate.
 	return UGridUtilities::WorldToGrid(TilePosition, GridSizeX, GridSizeY, TileSize);
 }
 
-TWeakObjectPtr<ATile> AGridManager::GetTile(const FString& TileName) const
+FString AGridManager::GetTileName(const FGridCoord& Coord) const
+{
+	// Produce the display name of the tile.
+	return UGridUtilities::GetCoordinateName(Coord.X, Coord.Y, GridSizeX, GridSizeY);
+}
+
+TWeakObjectPtr<ATile> AGridManager::GetTile(const FGridCoord& Coord) const
+{
+	// Retrieve a tile from the grid using its coordinate.
+	return UGridUtilities::GetTile(Grid, Coord);
+}
+
+FGridCoord AGridManager::PickTile(const FVector& RayOrigin, const FVector& RayDirection) const
+{
+	// Tiles are laid out relative to the grid manager, so the ray is brought into its space first.
+	const FTransform& Transform = GetActorTransform();
+	return UGridUtilities::RayToGrid(Transform.InverseTransformPosition(RayOrigin), Transform.InverseTransformVector(RayDirection), GridSizeX, GridSizeY, TileSize);
+}
+
+bool AGridManager::IsObstacle(const FGridCoord& Coord) const
+{
+	// Tiles outside the grid are treated as obstacles.
+	const int32 Index = Grid.ToIndex(Coord);
+	return Index == INDEX_NONE || Grid.IsObstacle(Index);
+}
+
+TArray<FGridCoord> AGridManager::GetNeighbours(const FGridCoord& Coord) const
 {
-	// Retrieve a tile from the grid using its name.
-	return UGridUtilities::GetTile(TileMap, TileName);
+	// Retrieve the coordinates of neighboring tiles for a given tile.
+	return UGridUtilities::GetNeighbors(Grid, Coord);
 }
 
-TArray<FString> AGridManager::GetNeighbours(const FString& TileName) const
+TArray<FGridCoord> AGridManager::FindPath(const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied) const
 {
-	// Retrieve the names of neighboring tiles for a given tile.
-	return UGridUtilities::GetNeighborsName(TileName, GridSizeX, GridSizeY, TileSize);
+	// Distant tiles go through the sector hierarchy when it is enabled.
+	if (bUseHierarchicalPathfinding && Hierarchy.IsBuilt())
+	{
+		TArray<FGridCoord> Path;
+		if (Hierarchy.TryFindPath(Grid, StartTile, EndTile, Occupied, SearchScratch, Path)) return Path;
+	}
+
+	// Find a path from the start tile to the end tile using the configured search.
+	if (PathSearch == EGridPathSearch::JumpPoint)
+	{
+		return UPathfindingUtilities::GetJumpPointPath(Grid, StartTile, EndTile, Occupied, SearchScratch);
+	}
+
+	return UPathfindingUtilities::GetPath(Grid, StartTile, EndTile, Occupied, SearchScratch);
 }
 
-TArray<FString> AGridManager::FindPath(const FString& StartTile, const FString& EndTile, const TArray<FString>& OccupiedTiles) const
+TArray<FGridCoord> AGridManager::FindArea(const FGridCoord& CenterTile, const int32 Size, const bool ConsiderObstacles, const TBitArray<>& Occupied) const
 {
-	// Find a path from the start tile to the end tile using the A* algorithm.
-	return UPathfindingUtilities::GetPath(TileMap, StartTile, EndTile, GridSizeX, GridSizeY, TileSize, OccupiedTiles);
+	// Copy the area out of the reusable buffer.
+	return TArray<FGridCoord>(FindAreaView(CenterTile, Size, ConsiderObstacles, Occupied));
 }
 
-TArray<FString> AGridManager::FindArea(const FString& CenterTile, const int32 Size, const bool ConsiderObstacles, const TArray<FString>& OccupiedTiles) const
+TConstArrayView<FGridCoord> AGridManager::FindAreaView(const FGridCoord& CenterTile, const int32 Size, const bool ConsiderObstacles, const TBitArray<>& Occupied) const
 {
 	// Find all tiles within a specified range from the center tile using BFS.
-	return UPathfindingUtilities::GetArea(TileMap, CenterTile, Size, ConsiderObstacles, GridSizeX, GridSizeY, TileSize, OccupiedTiles);
+	return UPathfindingUtilities::GetArea(Grid, CenterTile, Size, ConsiderObstacles, Occupied, FloodScratch);
+}
+
+void AGridManager::WarmDistanceFields(const TBitArray<>& Occupied) const
+{
+	// Build one field per unit position.
+	DistanceFields->Warm(Occupied);
+}
+
+TConstArrayView<FGridCoord> AGridManager::FindMovementRange(const FGridCoord& UnitTile, const int32 Range, const TBitArray<>& Occupied) const
+{
+	// Scan the diamond around the unit against its cached distance field.
+	return DistanceFields->GetReachable(UnitTile, Range, Occupied);
 }
 
-void AGridManager::ColorTiles(TArray<FString>& Tiles, const FLinearColor Color) const
+int32 AGridManager::GetPathDistance(const FGridCoord& SourceTile, const FGridCoord& TargetTile, const TBitArray<>& Occupied) const
 {
-	// Color the specified tiles with the given color.
-	for (auto TileName : Tiles)
+	// Look the target up in the cached distance field of the source.
+	return DistanceFields->GetDistance(SourceTile, TargetTile, Occupied);
+}
+
+void AGridManager::NotifyOccupancyChanged(const FGridCoord& Coord) const
+{
+	// Drop the fields that went through or around the tile.
+	DistanceFields->InvalidateTile(Coord);
+}
+
+void AGridManager::ColorTiles(const TArray<FGridCoord>& Tiles, const FLinearColor Color)
+{
+	// Color the specified tiles with the given color at the next flush.
+	for (const FGridCoord& Coord : Tiles)
 	{
-		ATile* Tile = TileMap[TileName].Get();
-		Tile->SetBaseColor(Color);
-		Tile->UpdateMaterial();
+		const int32 Index = Grid.ToIndex(Coord);
+		if (Index != INDEX_NONE) RequestTileColor(Index, Color);
 	}
 }
 
+void AGridManager::SetHighlight(const TArray<FGridCoord>& Tiles, const FLinearColor Color)
+{
+	// Tiles of the previous set and preview go back to their heatmap tint unless the new set claims them below.
+	for (const int32 Index : HighlightedTiles)
+	{
+		RequestTileColor(Index, BaseColors[Index]);
+		HighlightMask[Index] = false;
+	}
+	for (const int32 Index : PreviewTiles)
+	{
+		RequestTileColor(Index, BaseColors[Index]);
+		PreviewMask[Index] = false;
+	}
+	HighlightedTiles.Reset();
+	PreviewTiles.Reset();
+	HighlightColor = Color;
+
+	for (const FGridCoord& Coord : Tiles)
+	{
+		const int32 Index = Grid.ToIndex(Coord);
+		if (Index == INDEX_NONE) continue;
+
+		RequestTileColor(Index, Color);
+		HighlightedTiles.Add(Index);
+		HighlightMask[Index] = true;
+	}
+}
+
+void AGridManager::ClearHighlight()
+{
+	// An empty set whitens the previous one.
+	SetHighlight(TArray<FGridCoord>(), FLinearColor::White);
+}
+
+void AGridManager::SetPathPreview(TConstArrayView<FGridCoord> Path, const FLinearColor& Color)
+{
+	// Tiles of the previous preview fall back to the highlight or heatmap tint under them, unless the new preview claims them below.
+	for (const int32 Index : PreviewTiles)
+	{
+		RequestTileColor(Index, HighlightMask[Index] ? HighlightColor : BaseColors[Index]);
+		PreviewMask[Index] = false;
+	}
+	PreviewTiles.Reset();
+
+	for (const FGridCoord& Coord : Path)
+	{
+		const int32 Index = Grid.ToIndex(Coord);
+		if (Index == INDEX_NONE) continue;
+
+		RequestTileColor(Index, Color);
+		PreviewTiles.Add(Index);
+		PreviewMask[Index] = true;
+	}
+}
+
+void AGridManager::SetHeatmap(TConstArrayView<float> Weights, const FLinearColor& Color)
+{
+	check(Weights.IsEmpty() || Weights.Num() == Grid.Num());
+
+	// The highlight and preview stay on top; their tiles take the stored tint once the highlight or preview leaves them.
+	for (int32 Index = 0; Index < Grid.Num(); ++Index)
+	{
+		BaseColors[Index] = Weights.IsEmpty() ? FLinearColor::White : FMath::Lerp(FLinearColor::White, Color, FMath::Clamp(Weights[Index], 0.f, 1.f));
+		if (HighlightMask[Index] || PreviewMask[Index]) continue;
+
+		RequestTileColor(Index, BaseColors[Index]);
+	}
+}
+
+const FGridData& AGridManager::GetGridData() const
+{
+	// Return the flat grid model.
+	return Grid;
+}
+
 int32 AGridManager::GetGridSizeX() const
 {
 	// Return the width of the grid.
@@ -130,6 +431,69 @@ void AGridManager::BeginPlay()
 	Super::BeginPlay();
 }
 
+void AGridManager::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Apply every color change of this frame at once, then sleep until the next one.
+	FlushTileColors();
+	SetActorTickEnabled(false);
+}
+
+void AGridManager::SyncInstanceObstacles() const
+{
+	for (int32 Index = 0; Index < Grid.Num(); ++Index)
+	{
+		TileInstances->SetCustomDataValue(Index, ETileCustomData::IsObstacle, Grid.IsObstacle(Index) ? 1.f : 0.f);
+	}
+	TileInstances->MarkRenderStateDirty();
+}
+
+void AGridManager::RequestTileColor(const int32 Index, const FLinearColor& Color)
+{
+	RequestedColors[Index] = Color;
+
+	if (!DirtyMask[Index])
+	{
+		DirtyMask[Index] = true;
+		DirtyTiles.Add(Index);
+	}
+
+	SetActorTickEnabled(true);
+}
+
+void AGridManager::FlushTileColors()
+{
+	bool bInstancesChanged = false;
+
+	for (const int32 Index : DirtyTiles)
+	{
+		DirtyMask[Index] = false;
+
+		// A tile that was recolored and restored within the frame is left alone.
+		const FLinearColor& Color = RequestedColors[Index];
+		if (DisplayedColors[Index] == Color) continue;
+		DisplayedColors[Index] = Color;
+
+		if (bUseInstances)
+		{
+			TileInstances->SetCustomDataValue(Index, ETileCustomData::BaseColorR, Color.R);
+			TileInstances->SetCustomDataValue(Index, ETileCustomData::BaseColorG, Color.G);
+			TileInstances->SetCustomDataValue(Index, ETileCustomData::BaseColorB, Color.B);
+			bInstancesChanged = true;
+		}
+		else if (ATile* Tile = Grid.Tiles[Index].Get())
+		{
+			Tile->SetBaseColor(Color);
+			Tile->UpdateBaseColor();
+		}
+	}
+	DirtyTiles.Reset();
+
+	// A single render state update for the whole batch.
+	if (bInstancesChanged) TileInstances->MarkRenderStateDirty();
+}
+
 void AGridManager::SetObstaclePercentage(float NewObstaclePercentage)
 {
 	// Update the obstacle percentage for the grid.
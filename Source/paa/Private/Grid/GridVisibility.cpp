@@ -0,0 +1,138 @@
+#include "Grid/GridVisibility.h"
+
+bool FGridVisibility::HasLineOfSight(const FGridData& Grid, const FGridCoord& From, const FGridCoord& To)
+{
+	if (Grid.ToIndex(From) == INDEX_NONE || Grid.ToIndex(To) == INDEX_NONE) return false;
+
+	const int32 NumX = FMath::Abs(To.X - From.X);
+	const int32 NumY = FMath::Abs(To.Y - From.Y);
+	const int32 StepX = FMath::Sign(To.X - From.X);
+	const int32 StepY = FMath::Sign(To.Y - From.Y);
+	const auto IsObstacle = [&Grid](const int32 X, const int32 Y) { return Grid.Obstacles[Y * Grid.SizeX + X]; };
+
+	int32 X = From.X;
+	int32 Y = From.Y;
+
+	for (int32 StepsX = 0, StepsY = 0; StepsX < NumX || StepsY < NumY;)
+	{
+		// Compares where the segment crosses the next column border and the next row border, in integers.
+		const int32 Decision = (1 + 2 * StepsX) * NumY - (1 + 2 * StepsY) * NumX;
+
+		if (Decision == 0)
+		{
+			// Exactly through a corner: the view squeezes between the two side cells unless both are walls.
+			if (IsObstacle(X + StepX, Y) && IsObstacle(X, Y + StepY)) return false;
+
+			X += StepX;
+			Y += StepY;
+			++StepsX;
+			++StepsY;
+		}
+		else if (Decision < 0)
+		{
+			X += StepX;
+			++StepsX;
+		}
+		else
+		{
+			Y += StepY;
+			++StepsY;
+		}
+
+		// The destination tile itself never blocks the view.
+		if ((StepsX < NumX || StepsY < NumY) && IsObstacle(X, Y)) return false;
+	}
+
+	return true;
+}
+
+void FGridVisibility::Build(const FGridData& Grid, const int32 InRange)
+{
+	Reset();
+
+	if (InRange <= 0 || Grid.Num() > MaxCachedCells) return;
+
+	Range = FMath::Min(InRange, MaxRange);
+	Span = 2 * Range + 1;
+	RowMasks.SetNumZeroed(Grid.Num() * Span);
+
+	for (int32 Cell = 0; Cell < Grid.Num(); ++Cell)
+	{
+		const FGridCoord From = Grid.ToCoord(Cell);
+		RowMasks[Cell * Span + Range] |= 1u << Range; // A tile always sees itself.
+
+		// Sight is symmetric, so each pair is cast once, from the tile above it (or to its left on the same row).
+		for (int32 OffsetY = 0; OffsetY <= Range; ++OffsetY)
+		{
+			const int32 Reach = Range - OffsetY;
+
+			for (int32 OffsetX = OffsetY == 0 ? 1 : -Reach; OffsetX <= Reach; ++OffsetX)
+			{
+				const FGridCoord To(From.X + OffsetX, From.Y + OffsetY);
+				const int32 ToCell = Grid.ToIndex(To);
+
+				if (ToCell == INDEX_NONE || !HasLineOfSight(Grid, From, To)) continue;
+
+				RowMasks[Cell * Span + Range + OffsetY] |= 1u << (Range + OffsetX);
+				RowMasks[ToCell * Span + Range - OffsetY] |= 1u << (Range - OffsetX);
+			}
+		}
+	}
+}
+
+void FGridVisibility::Reset()
+{
+	Range = 0;
+	Span = 0;
+	RowMasks.Empty();
+}
+
+bool FGridVisibility::IsVisible(const FGridData& Grid, const FGridCoord& From, const FGridCoord& To) const
+{
+	const int32 OffsetX = To.X - From.X;
+	const int32 OffsetY = To.Y - From.Y;
+
+	if (IsBuilt() && FMath::Abs(OffsetX) + FMath::Abs(OffsetY) <= Range)
+	{
+		check(RowMasks.Num() == Grid.Num() * Span);
+
+		const int32 Cell = Grid.ToIndex(From);
+		return Cell != INDEX_NONE && Grid.ToIndex(To) != INDEX_NONE && (GetRowMask(Cell, OffsetY) >> (Range + OffsetX) & 1) != 0;
+	}
+
+	return HasLineOfSight(Grid, From, To);
+}
+
+void FGridVisibility::AddVisibleArea(const FGridData& Grid, const FGridCoord& Center, const int32 InRange, FGridBitboard& InOutArea) const
+{
+	const int32 Cell = Grid.ToIndex(Center);
+	if (Cell == INDEX_NONE || InRange < 0) return;
+
+	if (IsBuilt() && InRange <= Range)
+	{
+		check(RowMasks.Num() == Grid.Num() * Span);
+
+		// Each cached row, trimmed to the row of the diamond, lands in the board as one or two word ORs.
+		for (int32 OffsetY = -InRange; OffsetY <= InRange; ++OffsetY)
+		{
+			const int32 Reach = InRange - FMath::Abs(OffsetY);
+			const uint32 Diamond = ((2u << (2 * Reach)) - 1) << (Range - Reach);
+
+			InOutArea.OrRowBits(Center.Y + OffsetY, Center.X - Range, GetRowMask(Cell, OffsetY) & Diamond);
+		}
+
+		return;
+	}
+
+	// Uncached: cast a ray to every tile of the diamond.
+	for (int32 OffsetY = -InRange; OffsetY <= InRange; ++OffsetY)
+	{
+		const int32 Reach = InRange - FMath::Abs(OffsetY);
+
+		for (int32 OffsetX = -Reach; OffsetX <= Reach; ++OffsetX)
+		{
+			const FGridCoord Tile(Center.X + OffsetX, Center.Y + OffsetY);
+			if (HasLineOfSight(Grid, Center, Tile)) InOutArea.Set(Tile, true);
+		}
+	}
+}
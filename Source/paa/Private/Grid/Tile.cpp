@@ -10,13 +10,12 @@ ATile::ATile()
     // This actor does not require ticking.
     PrimaryActorTick.bCanEverTick = false;
 
-    TextureIndex = FMath::RandRange(0, 2);
-    
     // Create the static mesh component and set it as the RootComponent.
     TileMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("TileMesh"));
     if (TileMesh)
     {
         RootComponent = TileMesh;
+        TileMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision); // Tiles are picked analytically, see AGridManager::PickTile.
     }
     else
     {
@@ -101,6 +100,15 @@ void ATile::UpdateMaterial() const
     }
 }
 
+// Update only the base color parameter.
+void ATile::UpdateBaseColor() const
+{
+    if (TileMaterial)
+    {
+        TileMaterial->SetVectorParameterValue(TEXT("BaseColor"), BaseColor);
+    }
+}
+
 // Called when the actor is constructed or modified in the editor.
 void ATile::OnConstruction(const FTransform& Transform)
 {
@@ -1,56 +1,61 @@
 #include "Grid/Utils/GridUtilities.h"
 
-TWeakObjectPtr<ATile> UGridUtilities::GetTile(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const FString& TileName)
+TWeakObjectPtr<ATile> UGridUtilities::GetTile(const FGridData& Grid, const FGridCoord& Coord)
 {
-	// Look up the tile in the map.
-	if (const TWeakObjectPtr<ATile>* FoundTile = TileMap.Find(TileName))
+	// Look up the tile by its flat index.
+	const int32 Index = Grid.ToIndex(Coord);
+	if (Index != INDEX_NONE)
 	{
 		// Return the weak pointer directly.
-		return *FoundTile;
-	} 
+		return Grid.Tiles[Index];
+	}
 	// Return an empty weak pointer if not found.
 	return TWeakObjectPtr<ATile>();
 }
 
-FVector UGridUtilities::GridToWorld(const FString& TileName, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
+FVector UGridUtilities::GridToWorld(const FGridCoord& Coord, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
 {
-	// Ensure the TileName is at least 2 characters long.
-	if (TileName.Len() < 2)
+	// Ensure the coordinate is within the grid bounds.
+	if (Coord.X < 0 || Coord.X >= GridSizeX || Coord.Y < 0 || Coord.Y >= GridSizeY)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("GridToWorld: Invalid TileName '%s' (too short)."), *TileName);
-		return FVector::ZeroVector;
-	}
-    
-	// Extract the column letter (assumes a single letter column, e.g., 'A' ... 'Y').
-	TCHAR ColumnChar = TileName[0];
-	int32 ColumnIndex = ColumnChar - 'A';
-    
-	// Extract the row part (the rest of the string) and convert it to an integer.
-	FString RowString = TileName.Mid(1);  // Get everything after the first character.
-	int32 RowNumber = FCString::Atoi(*RowString);
-    
-	// Convert from 1-indexed row number (e.g., "1" for the first row) to a zero-based index.
-	int32 RowIndex = RowNumber - 1;
-
-	// Optionally, add bounds checking here to ensure that ColumnIndex and RowIndex are within valid ranges.
-	if (ColumnIndex < 0 || ColumnIndex >= GridSizeX || RowIndex < 0 || RowIndex >= GridSizeY)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("GridToWorld: TileName '%s' out of grid bounds."), *TileName);
+		UE_LOG(LogTemp, Warning, TEXT("GridToWorld: Coordinate (%d, %d) out of grid bounds."), Coord.X, Coord.Y);
 		return FVector::ZeroVector;
 	}
     
 	// Calculate and return the world location.
-	return FVector(ColumnIndex * TileSize, (GridSizeY - RowIndex - 1) * TileSize, 0.0f);
+	return FVector(Coord.X * TileSize, (GridSizeY - Coord.Y - 1) * TileSize, 0.0f);
 }
 
-FString UGridUtilities::WorldToGrid(const FVector& TilePosition, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
+FGridCoord UGridUtilities::WorldToGrid(const FVector& TilePosition, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
 {
 	// Convert world position to grid coordinates.
 	const int32 X = FMath::FloorToInt(TilePosition.X / TileSize);
-	const int32 Y = FMath::FloorToInt(TilePosition.Y / TileSize);
+	const int32 Y = GridSizeY - FMath::FloorToInt(TilePosition.Y / TileSize) - 1;
 
-	// Convert grid coordinates to a tile name.
-	return GetCoordinateName(X, GridSizeY - Y - 1, GridSizeX, GridSizeY);
+	// Return an unset coordinate for positions outside the grid.
+	if (X < 0 || X >= GridSizeX || Y < 0 || Y >= GridSizeY) return FGridCoord();
+	
+	return FGridCoord(X, Y);
+}
+
+FGridCoord UGridUtilities::RayToGrid(const FVector& RayOrigin, const FVector& RayDirection, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
+{
+	// A ray parallel to the plane, or pointing away from it, never reaches the grid.
+	if (FMath::IsNearlyZero(RayDirection.Z)) return FGridCoord();
+
+	const double Distance = -RayOrigin.Z / RayDirection.Z;
+	if (Distance < 0.0) return FGridCoord();
+
+	const FVector Point = RayOrigin + RayDirection * Distance;
+
+	// Tiles are centred on their position, so the nearest position names the tile.
+	const int32 X = FMath::FloorToInt(Point.X / TileSize + 0.5);
+	const int32 Y = GridSizeY - FMath::FloorToInt(Point.Y / TileSize + 0.5) - 1;
+
+	// Return an unset coordinate for points outside the grid.
+	if (X < 0 || X >= GridSizeX || Y < 0 || Y >= GridSizeY) return FGridCoord();
+
+	return FGridCoord(X, Y);
 }
 
 FString UGridUtilities::GetCoordinateName(const int32 X, const int32 Y, const int32 GridSizeX, const  int32 GridSizeY)
@@ -71,45 +76,37 @@ FVector UGridUtilities::GetCoordinate(const int32 X, const int32 Y, const int32
 	return FVector(X * TileSize, (GridSizeY - Y - 1) * TileSize, 0.0f);
 }
 
-TArray<FString> UGridUtilities::GetNeighborsName(const FString& TileName, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
+TArray<FGridCoord> UGridUtilities::GetNeighbors(const FGridData& Grid, const FGridCoord& Coord)
 {
-	TArray<FString> Neighbours;
+	TArray<FGridCoord> Neighbours;
 
-	// Get the world position of the tile.
-	const FVector TilePos = GridToWorld(TileName, GridSizeX, GridSizeY, TileSize);
+	const int32 Index = Grid.ToIndex(Coord);
+	if (Index == INDEX_NONE) return Neighbours;
 
-	// Define the four cardinal directions.
-	const FVector Directions[] = {
-		FVector(0, TileSize, 0),  // North
-		FVector(0, -TileSize, 0), // South
-		FVector(-TileSize, 0, 0), // West
-		FVector(TileSize, 0, 0)   // East
-	};
+	// Check each cardinal direction for a valid neighboring tile.
+	int32 NeighborIndices[4];
+	const int32 Count = Grid.GetNeighbors(Index, NeighborIndices);
 
-	// Check each direction for a valid neighboring tile.
-	for (const FVector& Dir : Directions)
+	for (int32 i = 0; i < Count; ++i)
 	{
-		const FVector AdjacentPos = TilePos + Dir;
-		const FString AdjacentName = WorldToGrid(AdjacentPos, GridSizeX, GridSizeY, TileSize);
-		if (!AdjacentName.IsEmpty())
-		{
-			Neighbours.Add(AdjacentName); // Add the neighboring tile name to the list.
-		}
+		Neighbours.Add(Grid.ToCoord(NeighborIndices[i])); // Add the neighboring tile coordinate to the list.
 	}
 
 	return Neighbours;
 }
 
-TArray<TWeakObjectPtr<ATile>> UGridUtilities::GetNeighbors(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const FString& TileName, const int32 GridSizeX, const int32 GridSizeY, const float TileSize)
+TBitArray<> UGridUtilities::MakeMask(const FGridData& Grid, const TArray<FGridCoord>& Coords)
 {
-	TArray<TWeakObjectPtr<ATile>> Neighbours;
+	TBitArray<> Mask(false, Grid.Num());
 
-	// Get the names of neighboring tiles.
-	for (TArray<FString> Names = GetNeighborsName(TileName, GridSizeX, GridSizeY, TileSize); const auto& Name : Names)
+	// Mark every listed coordinate that lies inside the grid.
+	for (const FGridCoord& Coord : Coords)
 	{
-		// Add the neighboring tile to the list.
-		Neighbours.Add(TileMap[Name]);
+		if (const int32 Index = Grid.ToIndex(Coord); Index != INDEX_NONE)
+		{
+			Mask[Index] = true;
+		}
 	}
-	
-	return Neighbours;
-}
\ No newline at end of file
+
+	return Mask;
+}
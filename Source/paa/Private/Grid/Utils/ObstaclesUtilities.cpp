@@ -1,65 +1,120 @@
 #include "Grid/Utils/ObstaclesUtilities.h"
 
-#include "Grid/Utils/GridUtilities.h"
+void UObstaclesUtilities::ResetTiles(FGridData& Grid)
+{
+    // Mark every cell as an obstacle and update the tiles in one pass.
+    Grid.Obstacles.Init(true, Grid.Num());
+    SyncTiles(Grid);
+}
 
-void UObstaclesUtilities::GenerateObstacles(TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const int32 GridSizeX, const int32 GridSizeY, const float TileSize, const float ObstaclePercentage)
+void UObstaclesUtilities::GenerateObstacles(FGridData& Grid, const float ObstaclePercentage, const int32 Seed)
 {
-    // Reset all tiles to their default state (no obstacles).
-    ResetTiles(TileMap);
+    // Produce the final obstacle mask first, then push it to the tiles once.
+    FMatchRng Stream(uint32(Seed));
+    CarveObstacles(Grid, ObstaclePercentage, Stream);
+    SyncTiles(Grid);
+}
 
-    // Calculate the total number of obstacles to generate based on the percentage.
-    const int32 TotalObstacles = FMath::FloorToInt(GridSizeX * GridSizeY * ObstaclePercentage);
-    TArray Explored = TArray<FString>(); // Tracks tiles that have already been processed.
+void UObstaclesUtilities::CarveObstacles(FGridData& Grid, const float ObstaclePercentage, FMatchRng& Stream)
+{
+    // Start from a grid made only of obstacles.
+    Grid.Obstacles.Init(true, Grid.Num());
 
-    // Choose a random starting tile for the DFS.
-    const int32 X = FMath::RandRange(0, GridSizeX - 1);
-    const int32 Y = FMath::RandRange(0, GridSizeY - 1);
-    const FString Current = UGridUtilities::GetCoordinateName(X, Y, GridSizeX, GridSizeY);
+    // Calculate how many tiles have to be carved free.
+    const int32 TotalObstacles = FMath::FloorToInt(Grid.Num() * FMath::Clamp(ObstaclePercentage, 0.f, 1.f));
+    const int32 TotalFree = Grid.Num() - TotalObstacles;
+    if (TotalFree <= 0) return;
 
-    // Perform DFS to generate obstacles.
-    DFS(TileMap, Explored, Current, GridSizeX, GridSizeY, TileSize, TotalObstacles);
-}
+    // Explicit DFS stack; every carved tile pushes at most four neighbours.
+    TArray<int32> Stack;
+    Stack.Reserve(Grid.Num());
 
-void UObstaclesUtilities::DFS(TMap<FString, TWeakObjectPtr<ATile>>& TileMap, TArray<FString>& Explored,
-    const FString& Current, const int32 GridSizeX, const int32 GridSizeY, const float TileSize, const int32 TotalObstacles)
-{
-    // Stop if the current tile is invalid, already processed, or the obstacle limit is reached.
-    if (!TileMap.Contains(Current) || !TileMap[Current]->IsObstacle() || TileMap.Num() - Explored.Num() <= TotalObstacles) return;
+    // Choose a random starting tile.
+    Stack.Add(Stream.RandRange(0, Grid.Num() - 1));
+    int32 FreeCount = 0;
+
+    while (Stack.Num() > 0 && FreeCount < TotalFree)
+    {
+        const int32 Current = Stack.Pop(EAllowShrinking::No);
+
+        // A tile can be pushed by several neighbours; only the first pop carves it.
+        if (!Grid.IsObstacle(Current)) continue;
 
-    // Mark the current tile as not being an obstacle.
-    TileMap[Current]->SetIsObstacle(false);
-    TileMap[Current]->UpdateMaterial(); // Update the tile's visual representation.
-    
-    // Add the current tile to the list of explored tiles.
-    Explored.Add(Current);
+        Grid.Obstacles[Current] = false;
+        FreeCount++;
 
-    // Get the neighboring tiles.
-    TArray<FString> Neighbors = UGridUtilities::GetNeighborsName(Current, GridSizeX, GridSizeY, TileSize);
+        // Get the neighboring tiles.
+        int32 Neighbors[4];
+        const int32 NeighborCount = Grid.GetNeighbors(Current, Neighbors);
+
+        // Shuffle the neighbors to randomize the traversal.
+        for (int32 i = NeighborCount - 1; i > 0; --i)
+        {
+            const int32 j = Stream.RandRange(0, i);
+            Swap(Neighbors[i], Neighbors[j]);
+        }
+
+        // Push in reverse so the first shuffled neighbour is explored first, as a recursive DFS would.
+        for (int32 i = NeighborCount - 1; i >= 0; --i)
+        {
+            if (Grid.IsObstacle(Neighbors[i])) Stack.Add(Neighbors[i]);
+        }
+    }
+}
 
-    // Shuffle the neighbors to randomize the DFS traversal.
-    for (int32 i = Neighbors.Num() - 1; i > 0; --i)
+bool UObstaclesUtilities::AreFreeTilesConnected(const FGridData& Grid)
+{
+    // Count the free tiles and remember the first one as the flood fill origin.
+    int32 FreeCount = 0;
+    int32 Origin = INDEX_NONE;
+    for (int32 Index = 0; Index < Grid.Num(); ++Index)
     {
-        const int32 j = FMath::RandRange(0, i);
-        Neighbors.Swap(i, j);
+        if (Grid.IsObstacle(Index)) continue;
+
+        if (Origin == INDEX_NONE) Origin = Index;
+        FreeCount++;
     }
 
-    // Recursively process each neighbor.
-    for (const FString& Neighbor : Neighbors)
+    if (FreeCount == 0) return true;
+
+    // Flood fill from the origin; the grid is connected if every free tile is reached.
+    TBitArray<> Visited(false, Grid.Num());
+    TArray<int32> Queue;
+    Queue.SetNumUninitialized(FreeCount);
+
+    int32 Head = 0;
+    int32 Tail = 0;
+    Queue[Tail++] = Origin;
+    Visited[Origin] = true;
+
+    while (Head < Tail)
     {
-        DFS(TileMap, Explored, Neighbor, GridSizeX, GridSizeY, TileSize, TotalObstacles);
+        int32 Neighbors[4];
+        const int32 NeighborCount = Grid.GetNeighbors(Queue[Head++], Neighbors);
+
+        for (int32 i = 0; i < NeighborCount; ++i)
+        {
+            const int32 Neighbor = Neighbors[i];
+            if (Visited[Neighbor] || Grid.IsObstacle(Neighbor)) continue;
+
+            Visited[Neighbor] = true;
+            Queue[Tail++] = Neighbor;
+        }
     }
+
+    return Tail == FreeCount;
 }
 
-void UObstaclesUtilities::ResetTiles(TMap<FString, TWeakObjectPtr<ATile>>& TileMap)
+void UObstaclesUtilities::SyncTiles(const FGridData& Grid)
 {
-    // Iterate through all tiles in the map.
-    for (auto& Elem : TileMap)
+    for (int32 Index = 0; Index < Grid.Num(); ++Index)
     {
-        if (Elem.Value.IsValid())
+        // Only tiles whose obstacle state actually changed need a material update.
+        ATile* Tile = Grid.Tiles[Index].Get();
+        if (Tile && Tile->IsObstacle() != Grid.IsObstacle(Index))
         {
-            // Reset the tile to its default state (obstacle).
-            Elem.Value->SetIsObstacle(true);
-            Elem.Value->UpdateMaterial(); // Update the tile's visual representation.
+            Tile->SetIsObstacle(Grid.IsObstacle(Index));
+            Tile->UpdateMaterial();
         }
     }
-}
\ No newline at end of file
+}
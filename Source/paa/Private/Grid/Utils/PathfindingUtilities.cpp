@@ -1,243 +1,525 @@
 #include "Grid/Utils/PathfindingUtilities.h"
 
-#include "Grid/Utils/GridUtilities.h"
 #include "Algo/Reverse.h"
 
-/**
- * Parses a tile name into grid coordinates (e.g., "A1" → (0, 0)).
- * @param TileName - The name of the tile in grid format (e.g., "A1").
- * @return A pair of integers representing the column and row indices.
- */
-TPair<int32, int32> ParseTileName(const FString& TileName)
+namespace
 {
-    if (TileName.Len() < 2)
+    /**
+     * Checks the end points of a path query, logging what is wrong with them.
+     * @return True if a path may exist: both tiles are inside the grid and free, except for the start which may be occupied.
+     */
+    bool IsPathQueryValid(const FGridData& Grid, const int32 Start, const int32 End, const TBitArray<>& Occupied)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Invalid tile name: %s"), *TileName);
-        return {-1, -1}; // Indicates invalid tile
+        if (Start == INDEX_NONE || End == INDEX_NONE)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Invalid start or end tile"));
+            return false;
+        }
+
+        if (Grid.IsObstacle(Start) || Grid.IsObstacle(End))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Start or End tile is obstacle"));
+            return false;
+        }
+
+        if (Occupied[End])
+        {
+            UE_LOG(LogTemp, Warning, TEXT("End tile is occupied"));
+            return false;
+        }
+
+        return true;
     }
 
-    // Extract column (e.g., 'A' → 0, 'B' → 1)
-    const TCHAR ColumnChar = TileName[0];
-    const int32 ColumnIndex = ColumnChar - 'A';
+    /**
+     * The grid as seen by a jump point search: the start counts as a wall, since no shortest path walks back into it,
+     * which also keeps an occupied start from being treated as free.
+     */
+    struct FJumpGrid
+    {
+        const FGridData& Grid;
+        const TBitArray<>& Occupied;
+        int32 Start;
+        int32 End;
+
+        /** @return True if the cell can be entered. */
+        bool IsFree(const int32 X, const int32 Y) const
+        {
+            if (X < 0 || X >= Grid.SizeX || Y < 0 || Y >= Grid.SizeY) return false;
 
-    // Extract row (e.g., "1" → 0, "2" → 1)
-    const FString RowString = TileName.Mid(1); // Get everything after the first character
-    const int32 RowIndex = FCString::Atoi(*RowString) - 1; // Convert to zero-based index
+            const int32 Index = Y * Grid.SizeX + X;
+            return Index != Start && !Grid.IsObstacle(Index) && !Occupied[Index];
+        }
 
-    return {ColumnIndex, RowIndex};
-}
+        /**
+         * Returns whether a horizontal move into a cell has a forced vertical neighbour:
+         * the cell beside the one it came from is blocked while the cell beside it is free.
+         */
+        bool HasForcedNeighbor(const int32 X, const int32 Y, const int32 DX) const
+        {
+            return (!IsFree(X - DX, Y - 1) && IsFree(X, Y - 1)) || (!IsFree(X - DX, Y + 1) && IsFree(X, Y + 1));
+        }
 
-/**
- * Calculates the Manhattan distance heuristic between two tiles.
- * @param A - The name of the first tile.
- * @param B - The name of the second tile.
- * @return The Manhattan distance between the two tiles.
- */
-float Heuristic(const FString& A, const FString& B)
-{
-    const TPair<int32, int32> CoordA = ParseTileName(A);
-    const TPair<int32, int32> CoordB = ParseTileName(B);
-    
-    return FMath::Abs(CoordA.Key - CoordB.Key) + FMath::Abs(CoordA.Value - CoordB.Value);
+        /**
+         * Walks horizontally from a cell until the next jump point.
+         * @return The flat index of the jump point, or INDEX_NONE if the walk hits a wall first.
+         */
+        int32 JumpHorizontal(int32 X, const int32 Y, const int32 DX) const
+        {
+            while (true)
+            {
+                X += DX;
+                if (!IsFree(X, Y)) return INDEX_NONE;
+
+                const int32 Index = Y * Grid.SizeX + X;
+                if (Index == End || HasForcedNeighbor(X, Y, DX)) return Index;
+            }
+        }
+
+        /**
+         * Walks vertically from a cell until the next jump point: a cell from which a horizontal walk finds one.
+         * @return The flat index of the jump point, or INDEX_NONE if the walk hits a wall first.
+         */
+        int32 JumpVertical(const int32 X, int32 Y, const int32 DY) const
+        {
+            while (true)
+            {
+                Y += DY;
+                if (!IsFree(X, Y)) return INDEX_NONE;
+
+                const int32 Index = Y * Grid.SizeX + X;
+                if (Index == End || JumpHorizontal(X, Y, -1) != INDEX_NONE || JumpHorizontal(X, Y, 1) != INDEX_NONE) return Index;
+            }
+        }
+    };
 }
 
-TArray<FString> UPathfindingUtilities::GetPath(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap,
-    const FString& StartTile, const FString& EndTile, int32 GridSizeX, int32 GridSizeY, float TileSize,
-    const TArray<FString>& OccupiedTiles)
+TArray<FGridCoord> UPathfindingUtilities::GetPath(const FGridData& Grid, const FGridCoord& StartTile,
+    const FGridCoord& EndTile, const TBitArray<>& Occupied, FGridSearchScratch& Scratch)
 {
-    TArray<FString> Path;
+    TArray<FGridCoord> Path;
 
-    // 1. Validate start/end tiles using safe access
-    const TWeakObjectPtr<ATile> StartTilePtr = TileMap.FindRef(StartTile);
-    const TWeakObjectPtr<ATile> EndTilePtr = TileMap.FindRef(EndTile);
+    // 1. Validate start/end tiles
+    const int32 Start = Grid.ToIndex(StartTile);
+    const int32 End = Grid.ToIndex(EndTile);
 
-    if (!StartTilePtr.IsValid() || !EndTilePtr.IsValid())
+    if (!IsPathQueryValid(Grid, Start, End, Occupied))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Invalid start or end tile"));
         return Path;
     }
 
-    if (StartTilePtr->IsObstacle() || EndTilePtr->IsObstacle())
+    if (Start == End)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Start or End tile is obstacle"));
+        Path.Add(StartTile);
         return Path;
     }
 
-    if (OccupiedTiles.Contains(EndTile))
+    // 2. Reset the reusable search state (O(1) thanks to generation stamps)
+    Scratch.Begin(Grid.Num());
+    const FGridSearchScratch::FOpenNodePredicate Predicate;
+
+    // Manhattan distance to the destination; admissible since entering a tile costs at least 1.
+    auto Heuristic = [&Grid, &EndTile](const int32 Index) { return Grid.ToCoord(Index).Distance(EndTile); };
+
+    Scratch.Reach(Start, 0, INDEX_NONE, 0);
+    Scratch.Heap.HeapPush({ Heuristic(Start), Heuristic(Start), Start }, Predicate);
+
+    // 3. A* Algorithm Implementation
+    while (Scratch.Heap.Num() > 0)
+    {
+        FGridSearchScratch::FOpenNode Node;
+        Scratch.Heap.HeapPop(Node, Predicate, EAllowShrinking::No);
+
+        const int32 Current = Node.Index;
+
+        // Skip entries that were superseded by a cheaper one or already expanded.
+        if (Scratch.IsClosed(Current) || Node.F - Node.H != Scratch.GScore[Current]) continue;
+        Scratch.Close(Current);
+
+        if (Current == End)
+        {
+            // Reconstruct path
+            Path.Reserve(Scratch.GScore[End] + 1);
+            for (int32 ReconstructCurrent = End; ReconstructCurrent != INDEX_NONE; ReconstructCurrent = Scratch.Parent[ReconstructCurrent])
+            {
+                Path.Add(Grid.ToCoord(ReconstructCurrent));
+            }
+            Algo::Reverse(Path);
+            return Path;
+        }
+
+        const int32 CurrentParent = Scratch.Parent[Current];
+        const int32 CurrentGScore = Scratch.GScore[Current];
+
+        // 4. Neighbor processing
+        int32 Neighbors[4];
+        const int32 NeighborCount = Grid.GetNeighbors(Current, Neighbors);
+
+        for (int32 i = 0; i < NeighborCount; ++i)
+        {
+            const int32 Neighbor = Neighbors[i];
+            
+            if (Grid.IsObstacle(Neighbor) || Occupied[Neighbor] || Scratch.IsClosed(Neighbor))
+                continue;
+
+            // 5. Relax the edge, paying the cost of the entered tile and counting a turn whenever the step changes direction
+            const int32 TentativeGScore = CurrentGScore + Grid.MovementCost[Neighbor];
+            const bool bTurns = CurrentParent != INDEX_NONE && Neighbor - Current != Current - CurrentParent;
+            const int32 TentativeTurns = Scratch.Turns[Current] + (bTurns ? 1 : 0);
+
+            if (!Scratch.IsOpened(Neighbor) || TentativeGScore < Scratch.GScore[Neighbor] ||
+                (TentativeGScore == Scratch.GScore[Neighbor] && TentativeTurns < Scratch.Turns[Neighbor]))
+            {
+                Scratch.Reach(Neighbor, TentativeGScore, Current, TentativeTurns);
+
+                const int32 H = Heuristic(Neighbor);
+                Scratch.Heap.HeapPush({ TentativeGScore + H, H, Neighbor }, Predicate);
+            }
+        }
+    }
+
+    return Path;
+}
+
+TArray<FGridCoord> UPathfindingUtilities::GetJumpPointPath(const FGridData& Grid, const FGridCoord& StartTile,
+    const FGridCoord& EndTile, const TBitArray<>& Occupied, FGridSearchScratch& Scratch)
+{
+    TArray<FGridCoord> Path;
+
+    const int32 Start = Grid.ToIndex(StartTile);
+    const int32 End = Grid.ToIndex(EndTile);
+
+    if (!IsPathQueryValid(Grid, Start, End, Occupied))
     {
-        UE_LOG(LogTemp, Warning, TEXT("End tile is occupied"));
         return Path;
-    }   
-    
-    if (StartTile == EndTile)
+    }
+
+    if (Start == End)
     {
         Path.Add(StartTile);
         return Path;
     }
 
-    // 2. Initialize scores for all possible grid coordinates
-    TMap<FString, FString> CameFrom;
-    TMap<FString, float> GScore;
-    TMap<FString, float> FScore;
-
-    for (int32 X = 0; X < GridSizeX; ++X)
+    // Jump points are only sound when every step costs the same.
+    if (!Grid.IsUniformCost())
     {
-        for (int32 Y = 0; Y < GridSizeY; ++Y)
-        {
-            const FString TileName = UGridUtilities::GetCoordinateName(X, Y, GridSizeX, GridSizeY);
-            GScore.Add(TileName, TNumericLimits<float>::Max());
-            FScore.Add(TileName, TNumericLimits<float>::Max());
-        }
+        return GetPath(Grid, StartTile, EndTile, Occupied, Scratch);
     }
 
-    GScore[StartTile] = 0.0f;
-    FScore[StartTile] = Heuristic(StartTile, EndTile);
+    const FJumpGrid Jumps{ Grid, Occupied, Start, End };
 
-    // 3. A* Algorithm Implementation
-    TArray<FString> OpenSet;
-    TSet<FString> OpenSetCheck;
-    OpenSet.Add(StartTile);
-    OpenSetCheck.Add(StartTile);
+    Scratch.Begin(Grid.Num());
+    const FGridSearchScratch::FOpenNodePredicate Predicate;
 
-    while (!OpenSet.IsEmpty())
+    Scratch.Reach(Start, 0, INDEX_NONE, 0);
+    Scratch.Heap.HeapPush({ StartTile.Distance(EndTile), StartTile.Distance(EndTile), Start }, Predicate);
+
+    // A* over jump points only; every edge is a straight run whose cost is its length.
+    while (Scratch.Heap.Num() > 0)
     {
-        // Sort by lowest FScore
-        OpenSet.Sort([&FScore](const FString& A, const FString& B) {
-            return FScore[A] < FScore[B];
-        });
+        FGridSearchScratch::FOpenNode Node;
+        Scratch.Heap.HeapPop(Node, Predicate, EAllowShrinking::No);
+
+        const int32 Current = Node.Index;
+
+        if (Scratch.IsClosed(Current) || Node.F - Node.H != Scratch.GScore[Current]) continue;
+        Scratch.Close(Current);
 
-        FString Current = OpenSet[0];
-        OpenSet.RemoveAt(0);
-        OpenSetCheck.Remove(Current);
+        const FGridCoord CurrentTile = Grid.ToCoord(Current);
 
-        if (Current == EndTile)
+        if (Current == End)
         {
-            // Reconstruct path
-            FString ReconstructCurrent = EndTile;
-            while (ReconstructCurrent != StartTile)
+            // Fill in the straight runs between consecutive jump points.
+            Path.Reserve(Scratch.GScore[End] + 1);
+            FGridCoord Tile = EndTile;
+            Path.Add(Tile);
+
+            for (int32 JumpPoint = Scratch.Parent[End]; JumpPoint != INDEX_NONE; JumpPoint = Scratch.Parent[JumpPoint])
             {
-                Path.Add(ReconstructCurrent);
-                ReconstructCurrent = CameFrom.FindRef(ReconstructCurrent);
+                const FGridCoord Target = Grid.ToCoord(JumpPoint);
+                const FGridCoord Step(FMath::Sign(Target.X - Tile.X), FMath::Sign(Target.Y - Tile.Y));
+
+                while (Tile != Target)
+                {
+                    Tile = FGridCoord(Tile.X + Step.X, Tile.Y + Step.Y);
+                    Path.Add(Tile);
+                }
             }
-            Path.Add(StartTile);
+
             Algo::Reverse(Path);
             return Path;
         }
 
-        // 4. Safe neighbor processing
-        const TArray<FString> Neighbors = UGridUtilities::GetNeighborsName(Current, GridSizeX, GridSizeY, TileSize);
+        // The direction the node was entered in decides which directions it may continue in:
+        // vertical moves may turn either way, horizontal moves only keep going (turns come from forced neighbours).
+        int32 Successors[4];
+        int32 SuccessorCount = 0;
 
-        for (const FString& Neighbor : Neighbors)
+        const int32 From = Scratch.Parent[Current];
+        if (From == INDEX_NONE)
         {
-            // Safe access pattern
-            const TWeakObjectPtr<ATile> NeighborTile = TileMap.FindRef(Neighbor);
-            const float CurrentGScore = GScore.FindRef(Current);
-            
-            if (!NeighborTile.IsValid() || NeighborTile->IsObstacle() || OccupiedTiles.Contains(Neighbor))
-                continue;
-
-            // 5. Safe score access using FindRef
-            const float TentativeGScore = CurrentGScore + 1.0f;
-            const float NeighborGScore = GScore.FindRef(Neighbor);
+            SuccessorCount = 4;
+            Successors[0] = Jumps.JumpVertical(CurrentTile.X, CurrentTile.Y, -1);
+            Successors[1] = Jumps.JumpVertical(CurrentTile.X, CurrentTile.Y, 1);
+            Successors[2] = Jumps.JumpHorizontal(CurrentTile.X, CurrentTile.Y, -1);
+            Successors[3] = Jumps.JumpHorizontal(CurrentTile.X, CurrentTile.Y, 1);
+        }
+        else
+        {
+            const FGridCoord FromTile = Grid.ToCoord(From);
+            const int32 DX = FMath::Sign(CurrentTile.X - FromTile.X);
+            const int32 DY = FMath::Sign(CurrentTile.Y - FromTile.Y);
 
-            if (TentativeGScore < NeighborGScore)
+            if (DY != 0)
+            {
+                Successors[SuccessorCount++] = Jumps.JumpVertical(CurrentTile.X, CurrentTile.Y, DY);
+                Successors[SuccessorCount++] = Jumps.JumpHorizontal(CurrentTile.X, CurrentTile.Y, -1);
+                Successors[SuccessorCount++] = Jumps.JumpHorizontal(CurrentTile.X, CurrentTile.Y, 1);
+            }
+            else
             {
-                CameFrom.Add(Neighbor, Current);
-                GScore.Add(Neighbor, TentativeGScore);
-                FScore.Add(Neighbor, TentativeGScore + Heuristic(Neighbor, EndTile));
+                Successors[SuccessorCount++] = Jumps.JumpHorizontal(CurrentTile.X, CurrentTile.Y, DX);
 
-                if (!OpenSetCheck.Contains(Neighbor))
+                for (const int32 Side : { -1, 1 })
                 {
-                    OpenSet.Add(Neighbor);
-                    OpenSetCheck.Add(Neighbor);
+                    if (!Jumps.IsFree(CurrentTile.X - DX, CurrentTile.Y + Side) && Jumps.IsFree(CurrentTile.X, CurrentTile.Y + Side))
+                    {
+                        Successors[SuccessorCount++] = Jumps.JumpVertical(CurrentTile.X, CurrentTile.Y, Side);
+                    }
                 }
             }
         }
+
+        for (int32 i = 0; i < SuccessorCount; ++i)
+        {
+            const int32 Successor = Successors[i];
+            if (Successor == INDEX_NONE || Scratch.IsClosed(Successor)) continue;
+
+            const FGridCoord SuccessorTile = Grid.ToCoord(Successor);
+            const int32 TentativeGScore = Scratch.GScore[Current] + CurrentTile.Distance(SuccessorTile);
+
+            if (!Scratch.IsOpened(Successor) || TentativeGScore < Scratch.GScore[Successor])
+            {
+                Scratch.Reach(Successor, TentativeGScore, Current, 0);
+
+                const int32 H = SuccessorTile.Distance(EndTile);
+                Scratch.Heap.HeapPush({ TentativeGScore + H, H, Successor }, Predicate);
+            }
+        }
     }
 
     return Path;
 }
 
-TArray<FString> UPathfindingUtilities::GetArea(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap,
-    const FString& CenterTile, const int32 Size, const bool ConsiderObstacles, const int32 GridSizeX,
-    const int32 GridSizeY, const float TileSize, const TArray<FString>& OccupiedTiles)
+TConstArrayView<FGridCoord> UPathfindingUtilities::GetArea(const FGridData& Grid, const FGridCoord& CenterTile,
+    const int32 Size, const bool ConsiderObstacles, const TBitArray<>& Occupied, FGridFloodScratch& Scratch)
 {
-    TArray<FString> ReachableTiles;
+    Scratch.Area.Reset();
+    TArray<FGridCoord>& ReachableTiles = Scratch.Area;
 
     // Ensure the center tile exists.
-    if (!TileMap.Contains(CenterTile))
+    const int32 Center = Grid.ToIndex(CenterTile);
+    if (Center == INDEX_NONE)
     {
         return ReachableTiles;
     }
 
-    TWeakObjectPtr<ATile> CenterTilePtr = TileMap[CenterTile];
-    if (!CenterTilePtr.IsValid())
+    if (!ConsiderObstacles)
     {
-        return ReachableTiles;
+        // Without obstacles every tile within Manhattan distance is reachable, so no search is needed.
+        Scratch.Reach.Init(Grid.SizeX, Grid.SizeY);
+        Scratch.Reach.SetDiamond(CenterTile, Size);
+    }
+    else
+    {
+        GetReach(Grid, Center, Size, Occupied, Scratch);
     }
 
-    // If obstacles should be considered and the center tile is blocked or occupied, return an empty area.
-    if (ConsiderObstacles && CenterTilePtr->IsObstacle())
+    Scratch.Reach.ForEachSetBit([&ReachableTiles](const FGridCoord& Tile) { ReachableTiles.Add(Tile); });
+
+    return ReachableTiles;
+}
+
+const FGridBitboard& UPathfindingUtilities::GetReach(const FGridData& Grid, const int32 Center, const int32 Range,
+    const TBitArray<>& Occupied, FGridFloodScratch& Scratch)
+{
+    FGridBitboard& Reach = Scratch.Reach;
+    Reach.Init(Grid.SizeX, Grid.SizeY);
+
+    // If the center tile is blocked, the area is empty.
+    if (!Grid.IsValidIndex(Center) || Grid.IsObstacle(Center))
     {
-        return ReachableTiles;
+        return Reach;
     }
 
-    // We'll perform a breadth-first search (BFS) using a queue.
-    // Each element is a pair (TileName, MovementCost) where MovementCost is how far the tile is from the center.
-    TArray<TPair<FString, int32>> Queue;
-    TSet<FString> Visited;
+    Reach.Set(Grid.ToCoord(Center), true);
 
-    // Start from the center tile, which is at distance 0.
-    Queue.Add(TPair<FString, int32>(CenterTile, 0));
-    Visited.Add(CenterTile);
+    if (Grid.IsUniformCost())
+    {
+        // Grow the center through the free tiles one step at a time; the center itself may be occupied.
+        Scratch.Walkable.SetWalkable(Grid, Occupied);
+        Reach.Dilate(Scratch.Walkable, Range);
+        return Reach;
+    }
 
-    while (Queue.Num() > 0)
+    // Dijkstra bounded by the range. Every cell given a distance is in range and marked in Reach,
+    // so the distances can be cleared again through Reach instead of the whole grid.
+    TArray<int32>& Distance = Scratch.Distance;
+    if (Distance.Num() != Grid.Num())
     {
-        // Pop the first element (FIFO).
-        TPair<FString, int32> CurrentPair = Queue[0];
-        Queue.RemoveAt(0);
+        Distance.Init(INDEX_NONE, Grid.Num());
+    }
 
-        FString CurrentTile = CurrentPair.Key;
-        int32 CurrentDistance = CurrentPair.Value;
+    FGridBucketQueue& Queue = Scratch.Queue;
+    Queue.Begin(Grid.MaxMovementCost);
+    Queue.Push(Center, 0);
+    Distance[Center] = 0;
 
-        // Add the current tile to the reachable list.
-        ReachableTiles.Add(CurrentTile);
+    int32 Current;
+    int32 CurrentDistance;
+    while (Queue.Pop(Current, CurrentDistance))
+    {
+        // Skip entries superseded by a cheaper one.
+        if (CurrentDistance != Distance[Current]) continue;
 
-        // If we haven't reached the movement limit, check the neighbors.
-        if (CurrentDistance < Size)
+        int32 Neighbors[4];
+        const int32 NeighborCount = Grid.GetNeighbors(Current, Neighbors);
+
+        for (int32 i = 0; i < NeighborCount; ++i)
         {
-            // Get the neighbors of the current tile.
-            TArray<FString> Neighbors = UGridUtilities::GetNeighborsName(CurrentTile, GridSizeX, GridSizeY, TileSize);
+            const int32 Neighbor = Neighbors[i];
+            const int32 NextDistance = CurrentDistance + Grid.MovementCost[Neighbor];
 
-            for (const FString& Neighbor : Neighbors)
+            if (NextDistance > Range || Grid.IsObstacle(Neighbor) || Occupied[Neighbor] ||
+                (Distance[Neighbor] != INDEX_NONE && Distance[Neighbor] <= NextDistance))
             {
-                // Skip if the neighbor is not part of the map.
-                if (!TileMap.Contains(Neighbor))
-                {
-                    continue;
-                }
+                continue;
+            }
 
-                TWeakObjectPtr<ATile> NeighborTile = TileMap[Neighbor];
-                if (!NeighborTile.IsValid())
-                {
-                    continue;
-                }
+            Distance[Neighbor] = NextDistance;
+            Reach.Set(Grid.ToCoord(Neighbor), true);
+            Queue.Push(Neighbor, NextDistance);
+        }
+    }
 
-                // If we must consider obstacles, then skip any neighbor that is an obstacle or occupied.
-                if (ConsiderObstacles && (NeighborTile->IsObstacle() || OccupiedTiles.Contains(Neighbor)))
-                {
-                    continue;
-                }
+    Reach.ForEachSetBit([&Grid, &Distance](const FGridCoord& Tile) { Distance[Grid.ToIndex(Tile)] = INDEX_NONE; });
 
-                // If the neighbor has not yet been visited, add it to the queue.
-                if (!Visited.Contains(Neighbor))
-                {
-                    Visited.Add(Neighbor);
-                    Queue.Add(TPair<FString, int32>(Neighbor, CurrentDistance + 1));
-                }
+    return Reach;
+}
+
+void UPathfindingUtilities::GetDistanceField(const FGridData& Grid, const int32 Source, const TBitArray<>& Occupied,
+    TArray<int32>& OutDistance, FGridBucketQueue& Queue)
+{
+    OutDistance.Init(INDEX_NONE, Grid.Num());
+
+    // An obstacle source reaches nothing, not even itself.
+    if (!Grid.IsValidIndex(Source) || Grid.IsObstacle(Source))
+    {
+        return;
+    }
+
+    // Dijkstra over a bucket queue; with unit costs the buckets pop in BFS order and every cell is queued once.
+    Queue.Begin(Grid.MaxMovementCost);
+    Queue.Push(Source, 0);
+    OutDistance[Source] = 0;
+
+    int32 CurrentTile;
+    int32 CurrentDistance;
+    while (Queue.Pop(CurrentTile, CurrentDistance))
+    {
+        // Skip entries superseded by a cheaper one.
+        if (CurrentDistance != OutDistance[CurrentTile])
+        {
+            continue;
+        }
+
+        int32 Neighbors[4];
+        const int32 NeighborCount = Grid.GetNeighbors(CurrentTile, Neighbors);
+
+        for (int32 i = 0; i < NeighborCount; ++i)
+        {
+            const int32 Neighbor = Neighbors[i];
+            const int32 NextDistance = CurrentDistance + Grid.MovementCost[Neighbor];
+
+            if (Grid.IsObstacle(Neighbor) || Occupied[Neighbor] ||
+                (OutDistance[Neighbor] != INDEX_NONE && OutDistance[Neighbor] <= NextDistance))
+            {
+                continue;
+            }
+
+            OutDistance[Neighbor] = NextDistance;
+            Queue.Push(Neighbor, NextDistance);
+        }
+    }
+}
+
+void UPathfindingUtilities::GetPathTree(const FGridData& Grid, const int32 Source, const int32 Range, const TBitArray<>& Occupied,
+    FGridPathTree& OutTree)
+{
+    OutTree.Source = Source;
+    OutTree.Range = Range;
+    OutTree.Distance.Init(INDEX_NONE, Grid.Num());
+    OutTree.Parent.Init(INDEX_NONE, Grid.Num());
+
+    // An obstacle source reaches nothing, not even itself.
+    if (!Grid.IsValidIndex(Source) || Grid.IsObstacle(Source))
+    {
+        return;
+    }
+
+    // The same bucket-queue Dijkstra as GetDistanceField, stopped at the range and recording where each cell was entered from.
+    FGridBucketQueue& Queue = OutTree.Queue;
+    Queue.Begin(Grid.MaxMovementCost);
+    Queue.Push(Source, 0);
+    OutTree.Distance[Source] = 0;
+
+    int32 CurrentTile;
+    int32 CurrentDistance;
+    while (Queue.Pop(CurrentTile, CurrentDistance))
+    {
+        // Skip entries superseded by a cheaper one.
+        if (CurrentDistance != OutTree.Distance[CurrentTile])
+        {
+            continue;
+        }
+
+        int32 Neighbors[4];
+        const int32 NeighborCount = Grid.GetNeighbors(CurrentTile, Neighbors);
+
+        for (int32 i = 0; i < NeighborCount; ++i)
+        {
+            const int32 Neighbor = Neighbors[i];
+            const int32 NextDistance = CurrentDistance + Grid.MovementCost[Neighbor];
+
+            if (NextDistance > Range || Grid.IsObstacle(Neighbor) || Occupied[Neighbor] ||
+                (OutTree.Distance[Neighbor] != INDEX_NONE && OutTree.Distance[Neighbor] <= NextDistance))
+            {
+                continue;
             }
+
+            OutTree.Distance[Neighbor] = NextDistance;
+            OutTree.Parent[Neighbor] = CurrentTile;
+            Queue.Push(Neighbor, NextDistance);
         }
     }
+}
 
-    return ReachableTiles;  
-}
\ No newline at end of file
+bool FGridPathTree::GetPath(const FGridData& Grid, const int32 Target, TArray<FGridCoord>& OutPath) const
+{
+    OutPath.Reset();
+
+    if (Source == INDEX_NONE || !Distance.IsValidIndex(Target) || Distance[Target] == INDEX_NONE)
+    {
+        return false;
+    }
+
+    check(Distance.Num() == Grid.Num());
+
+    for (int32 Current = Target; Current != INDEX_NONE; Current = Parent[Current])
+    {
+        OutPath.Add(Grid.ToCoord(Current));
+    }
+    Algo::Reverse(OutPath);
+
+    return true;
+}
@@ -0,0 +1,28 @@
+#include "Systems/BattleActionRecord.h"
+
+FBattleActionRecord FBattleActionRecord::MakeMove(const FBattleState& State, const int32 Unit, const FGridCoord& From)
+{
+	FBattleActionRecord Record;
+	Record.Kind = EBattleActionKind::Move;
+	Record.bPlayerTeam = State.Units.IsPlayer(Unit);
+	Record.UnitType = State.Units.Type[Unit];
+	Record.From = From;
+	Record.To = State.Units.Position[Unit];
+
+	return Record;
+}
+
+FBattleActionRecord FBattleActionRecord::MakeAttack(const FBattleState& State, const int32 Unit, const int32 Target, const FBattleAttackResult& Result)
+{
+	FBattleActionRecord Record;
+	Record.Kind = EBattleActionKind::Attack;
+	Record.bPlayerTeam = State.Units.IsPlayer(Unit);
+	Record.UnitType = State.Units.Type[Unit];
+	Record.TargetType = State.Units.Type[Target];
+	Record.From = State.Units.Position[Unit];
+	Record.To = State.Units.Position[Target]; // Dead units keep their last tile.
+	Record.Damage = Result.Damage;
+	Record.CounterDamage = Result.CounterDamage;
+
+	return Record;
+}
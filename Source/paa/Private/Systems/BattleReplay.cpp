@@ -0,0 +1,258 @@
+#include "Systems/BattleReplay.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	constexpr uint32 ReplayMagic = 0x52414150; // "PAAR" in a little-endian file.
+	constexpr uint16 ReplayVersion = 1;
+
+	// Layout of a record word: the kind in bits 30-31, the acting unit in bits 22-29,
+	// then either a cell (bits 0-21) or a target (bits 14-21), damage (bits 7-13) and counter damage + 1 (bits 0-6).
+	constexpr uint32 TypeShift = 30;
+	constexpr uint32 UnitShift = 22;
+	constexpr uint32 UnitMask = 0xFF;
+	constexpr uint32 CellMask = (1u << UnitShift) - 1;
+	constexpr uint32 TargetShift = 14;
+	constexpr uint32 DamageShift = 7;
+	constexpr uint32 DamageMask = 0x7F;
+
+	/**
+	 * Packs the kind and acting unit of a record.
+	 * @param Type - The kind of record.
+	 * @param Unit - The acting unit.
+	 * @return The word, with the payload bits left clear.
+	 */
+	uint32 PackHeader(const EReplayRecord Type, const int32 Unit)
+	{
+		check(Unit >= 0 && uint32(Unit) <= UnitMask);
+		return uint32(Type) << TypeShift | uint32(Unit) << UnitShift;
+	}
+}
+
+void FBattleReplay::Start(const int32 InSeed, const FGridData& Grid)
+{
+	Seed = InSeed;
+	Units.Reset();
+	Records.Reset();
+	TimesMs.Reset();
+	SetTerrain(Grid);
+
+	StartSeconds = FPlatformTime::Seconds();
+}
+
+void FBattleReplay::SetTerrain(const FGridData& Grid)
+{
+	check(uint32(Grid.Num()) <= CellMask + 1);
+
+	SizeX = Grid.SizeX;
+	SizeY = Grid.SizeY;
+	Obstacles = Grid.Obstacles;
+	MovementCost = Grid.IsUniformCost() ? TArray<uint8>() : Grid.MovementCost;
+}
+
+void FBattleReplay::RecordPlace(const int32 Unit, const FBattleUnitDesc& Desc)
+{
+	if (Units.Num() <= Unit) Units.SetNum(Unit + 1);
+	Units[Unit] = Desc;
+
+	Add(PackHeader(EReplayRecord::Place, Unit) | uint32(Desc.Position.Y * SizeX + Desc.Position.X));
+}
+
+void FBattleReplay::RecordMove(const int32 Unit, const FGridCoord& Tile)
+{
+	Add(PackHeader(EReplayRecord::Move, Unit) | uint32(Tile.Y * SizeX + Tile.X));
+}
+
+void FBattleReplay::RecordAttack(const int32 Unit, const int32 Target, const FBattleAttackResult& Result)
+{
+	check(Target >= 0 && uint32(Target) <= UnitMask);
+
+	// Damage is only kept to detect divergence, so larger values saturate.
+	const uint32 Damage = FMath::Min<uint32>(FMath::Max(Result.Damage, 0), DamageMask);
+	const uint32 Counter = FMath::Min<uint32>(FMath::Max(Result.CounterDamage + 1, 0), DamageMask);
+
+	Add(PackHeader(EReplayRecord::Attack, Unit) | uint32(Target) << TargetShift | Damage << DamageShift | Counter);
+}
+
+void FBattleReplay::RecordTurn(const bool bPlayerTurn)
+{
+	Add(PackHeader(EReplayRecord::Turn, bPlayerTurn ? 1 : 0));
+}
+
+FReplayAction FBattleReplay::Decode(const uint32 Record)
+{
+	FReplayAction Action;
+	Action.Type = EReplayRecord(Record >> TypeShift);
+
+	const int32 Unit = int32(Record >> UnitShift & UnitMask);
+
+	switch (Action.Type)
+	{
+	case EReplayRecord::Place:
+	case EReplayRecord::Move:
+		Action.Unit = Unit;
+		Action.Cell = int32(Record & CellMask);
+		break;
+	case EReplayRecord::Attack:
+		Action.Unit = Unit;
+		Action.Target = int32(Record >> TargetShift & UnitMask);
+		Action.Damage = int32(Record >> DamageShift & DamageMask);
+		Action.CounterDamage = int32(Record & DamageMask) - 1;
+		break;
+	case EReplayRecord::Turn:
+		Action.bPlayerTurn = Unit != 0;
+		break;
+	}
+
+	return Action;
+}
+
+FGridCoord FBattleReplay::ToCoord(const int32 Cell) const
+{
+	return Cell >= 0 && Cell < SizeX * SizeY ? FGridCoord(Cell % SizeX, Cell / SizeX) : FGridCoord();
+}
+
+FBattleState FBattleReplay::MakeInitialState() const
+{
+	FGridData Grid;
+	Grid.Init(SizeX, SizeY);
+	Grid.Obstacles = Obstacles;
+	Grid.SetMovementCosts(MovementCost);
+
+	FBattleState State;
+	State.Reset(Grid);
+
+	// The battle draws its damage from a fresh copy of the match's damage stream.
+	FMatchRandom Random;
+	Random.Initialize(Seed);
+	State.Random = Random.Get(ERandomStream::Damage);
+
+	return State;
+}
+
+int32 FBattleReplay::Simulate(FBattleState& OutState) const
+{
+	OutState = MakeInitialState();
+
+	FBattleRules Rules;
+	FBattleUndo Undo;
+
+	for (int32 Index = 0; Index < Records.Num(); ++Index)
+	{
+		const FReplayAction Action = Decode(Records[Index]);
+		const int32 NumUnits = OutState.Units.Num();
+
+		switch (Action.Type)
+		{
+		case EReplayRecord::Place:
+			{
+				// Units are recorded in the order they entered the battle state.
+				if (Action.Unit != NumUnits || !Units.IsValidIndex(Action.Unit)) return Index;
+
+				FBattleUnitDesc Desc = Units[Action.Unit];
+				Desc.Position = ToCoord(Action.Cell);
+				if (!Desc.Position.IsSet() || OutState.FindUnitAt(Desc.Position) != INDEX_NONE) return Index;
+
+				OutState.AddUnit(Desc);
+			}
+			break;
+		case EReplayRecord::Move:
+			{
+				const FGridCoord Tile = ToCoord(Action.Cell);
+				if (Action.Unit >= NumUnits || !Tile.IsSet() || !Rules.CanMove(OutState, Action.Unit, Tile)) return Index;
+
+				FBattleRules::ApplyMove(OutState, Action.Unit, Tile, Undo);
+			}
+			break;
+		case EReplayRecord::Attack:
+			{
+				if (Action.Unit >= NumUnits || Action.Target >= NumUnits ||
+					!FBattleRules::CanAttack(OutState, Action.Unit, Action.Target)) return Index;
+
+				const FBattleAttackResult Result = FBattleRules::ApplyAttack(OutState, Action.Unit, Action.Target, Undo);
+				if (FMath::Min<int32>(Result.Damage, DamageMask) != Action.Damage ||
+					FMath::Min<int32>(Result.CounterDamage, DamageMask - 1) != Action.CounterDamage) return Index;
+			}
+			break;
+		case EReplayRecord::Turn:
+			// A turn passing to the other team ends the current one; the first battle turn finds every action
+			// already reset, and a team being handed its own turn again (e.g. after a playback) keeps its actions.
+			if (Action.bPlayerTurn != OutState.bPlayerTurn) FBattleRules::EndTurn(OutState);
+			OutState.bPlayerTurn = Action.bPlayerTurn;
+			break;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool FBattleReplay::Serialize(FArchive& Ar)
+{
+	uint32 Magic = ReplayMagic;
+	uint16 Version = ReplayVersion;
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != ReplayMagic || Version != ReplayVersion)) return false;
+
+	uint16 Width = uint16(SizeX);
+	uint16 Height = uint16(SizeY);
+	Ar << Seed << Width << Height << Obstacles << MovementCost;
+	SizeX = Width;
+	SizeY = Height;
+
+	// Unit stats are small, so each field is stored in the narrowest type that holds it.
+	uint8 NumUnits = uint8(Units.Num());
+	Ar << NumUnits;
+	if (Ar.IsLoading()) Units.SetNum(NumUnits);
+
+	for (FBattleUnitDesc& Desc : Units)
+	{
+		uint8 Type = uint8(Desc.Type);
+		uint8 bPlayerTeam = Desc.bPlayerTeam ? 1 : 0;
+		uint16 LifePoints = uint16(Desc.LifePoints);
+		uint8 MovementRange = uint8(Desc.MovementRange);
+		uint8 AttackRange = uint8(Desc.AttackRange);
+		uint8 DamageMin = uint8(Desc.DamageMin);
+		uint8 DamageMax = uint8(Desc.DamageMax);
+		Ar << Type << bPlayerTeam << LifePoints << MovementRange << AttackRange << DamageMin << DamageMax;
+
+		Desc.Type = EUnitTypes(Type);
+		Desc.bPlayerTeam = bPlayerTeam != 0;
+		Desc.LifePoints = LifePoints;
+		Desc.MovementRange = MovementRange;
+		Desc.AttackRange = AttackRange;
+		Desc.DamageMin = DamageMin;
+		Desc.DamageMax = DamageMax;
+	}
+
+	Ar << Records << TimesMs;
+
+	return !Ar.IsError() && Obstacles.Num() == SizeX * SizeY && (MovementCost.Num() == 0 || MovementCost.Num() == SizeX * SizeY) &&
+		TimesMs.Num() == Records.Num();
+}
+
+bool FBattleReplay::SaveToFile(const FString& Filename)
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	return Serialize(Writer) && FFileHelper::SaveArrayToFile(Bytes, *Filename);
+}
+
+bool FBattleReplay::LoadFromFile(const FString& Filename)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Filename)) return false;
+
+	FMemoryReader Reader(Bytes);
+	return Serialize(Reader);
+}
+
+void FBattleReplay::Add(const uint32 Record)
+{
+	Records.Add(Record);
+	TimesMs.Add(uint32((FPlatformTime::Seconds() - StartSeconds) * 1000.0));
+}
@@ -0,0 +1,137 @@
+#include "Systems/BattleRules.h"
+
+bool FBattleRules::CanAct(const FBattleState& State, const int32 Unit)
+{
+	const FBattleUnits& Units = State.Units;
+
+	return Units.IsAlive(Unit) && Units.IsPlayer(Unit) == State.bPlayerTurn && Units.Action[Unit] == EActionType::None;
+}
+
+bool FBattleRules::CanMove(const FBattleState& State, const int32 Unit, const FGridCoord& Tile)
+{
+	const int32 Cell = State.Grid.ToIndex(Tile);
+	if (Cell == INDEX_NONE || !CanAct(State, Unit)) return false;
+
+	BuildReach(State, Unit);
+
+	return Flood.Reach.Get(Tile);
+}
+
+bool FBattleRules::CanAttack(const FBattleState& State, const int32 Unit, const int32 Target)
+{
+	const FBattleUnits& Units = State.Units;
+
+	// Units that already attacked this turn cannot attack again.
+	if (Units.Action[Unit] != EActionType::None && Units.Action[Unit] != EActionType::Move) return false;
+
+	return Units.IsAlive(Unit) && Units.IsAlive(Target) &&
+		Units.IsPlayer(Unit) == State.bPlayerTurn && Units.IsPlayer(Target) != Units.IsPlayer(Unit) &&
+			Units.Position[Unit].Distance(Units.Position[Target]) <= Units.AttackRange[Unit] &&
+			State.HasLineOfSight(Units.Position[Unit], Units.Position[Target]);
+}
+
+void FBattleRules::GetMoves(const FBattleState& State, const int32 Unit, TArray<FGridCoord>& OutTiles)
+{
+	OutTiles.Reset();
+
+	if (!CanAct(State, Unit)) return;
+
+	BuildReach(State, Unit);
+
+	// Staying is not a move; the rest comes out in row-major order.
+	const FGridCoord Position = State.Units.Position[Unit];
+	Flood.Reach.ForEachSetBit([&OutTiles, &Position](const FGridCoord& Tile) { if (Tile != Position) OutTiles.Add(Tile); });
+}
+
+void FBattleRules::ApplyMove(FBattleState& State, const int32 Unit, const FGridCoord& Tile, FBattleUndo& OutUndo)
+{
+	FBattleUnits& Units = State.Units;
+
+	OutUndo.Unit = Unit;
+	OutUndo.Target = INDEX_NONE;
+	OutUndo.From = Units.Position[Unit];
+	OutUndo.Action = Units.Action[Unit];
+
+	if (Tile != Units.Position[Unit])
+	{
+		State.Occupied[State.Grid.ToIndex(Units.Position[Unit])] = false;
+		State.Occupied[State.Grid.ToIndex(Tile)] = true;
+		Units.Position[Unit] = Tile;
+	}
+
+	if (Units.Action[Unit] == EActionType::None) Units.Action[Unit] = EActionType::Move;
+}
+
+FBattleAttackResult FBattleRules::ApplyAttack(FBattleState& State, const int32 Unit, const int32 Target, FBattleUndo& OutUndo)
+{
+	FBattleUnits& Units = State.Units;
+	FBattleAttackResult Result;
+
+	OutUndo.Unit = Unit;
+	OutUndo.Target = Target;
+	OutUndo.From = Units.Position[Unit];
+	OutUndo.Action = Units.Action[Unit];
+	OutUndo.UnitLifePoints = Units.LifePoints[Unit];
+	OutUndo.TargetLifePoints = Units.LifePoints[Target];
+	OutUndo.Random = State.Random;
+
+	// Apply damage to the defender.
+	Result.Damage = State.Random.RandRange(Units.DamageMin[Unit], Units.DamageMax[Unit]);
+	Units.LifePoints[Target] = FMath::Max(0, Units.LifePoints[Target] - Result.Damage);
+
+	// Snipers are countered, except by brawlers they shoot from a distance.
+	if (Units.Type[Unit] == EUnitTypes::Sniper &&
+		!(Units.Type[Target] == EUnitTypes::Brawler && Units.Position[Unit].Distance(Units.Position[Target]) != 1))
+	{
+		Result.CounterDamage = State.Random.RandRange(1, 3);
+		Units.LifePoints[Unit] = FMath::Max(0, Units.LifePoints[Unit] - Result.CounterDamage);
+	}
+
+	Units.Action[Unit] = Units.Action[Unit] == EActionType::Move ? EActionType::MoveAndAttack : EActionType::Attack;
+
+	// Dead units free their tile.
+	if (!Units.IsAlive(Target)) State.Occupied[State.Grid.ToIndex(Units.Position[Target])] = false;
+	if (!Units.IsAlive(Unit)) State.Occupied[State.Grid.ToIndex(Units.Position[Unit])] = false;
+
+	return Result;
+}
+
+void FBattleRules::Undo(FBattleState& State, const FBattleUndo& Undo)
+{
+	FBattleUnits& Units = State.Units;
+
+	Units.Action[Undo.Unit] = Undo.Action;
+
+	if (Undo.Target == INDEX_NONE)
+	{
+		State.Occupied[State.Grid.ToIndex(Units.Position[Undo.Unit])] = false;
+		State.Occupied[State.Grid.ToIndex(Undo.From)] = true;
+		Units.Position[Undo.Unit] = Undo.From;
+		return;
+	}
+
+	// Units killed by the attack take their tile back.
+	Units.LifePoints[Undo.Unit] = Undo.UnitLifePoints;
+	Units.LifePoints[Undo.Target] = Undo.TargetLifePoints;
+	State.Occupied[State.Grid.ToIndex(Units.Position[Undo.Unit])] = true;
+	State.Occupied[State.Grid.ToIndex(Units.Position[Undo.Target])] = true;
+	State.Random = Undo.Random;
+}
+
+void FBattleRules::EndTurn(FBattleState& State)
+{
+	FBattleUnits& Units = State.Units;
+
+	for (int32 Unit = 0; Unit < Units.Num(); ++Unit)
+	{
+		if (Units.IsPlayer(Unit) == State.bPlayerTurn) Units.Action[Unit] = EActionType::None;
+	}
+
+	State.bPlayerTurn = !State.bPlayerTurn;
+}
+
+void FBattleRules::BuildReach(const FBattleState& State, const int32 Unit)
+{
+	// Bitboard dilation on uniform-cost grids, a bounded Dijkstra over movement costs otherwise.
+	UPathfindingUtilities::GetReach(State.Grid, State.Grid.ToIndex(State.Units.Position[Unit]), State.Units.MovementRange[Unit], State.Occupied, Flood);
+}
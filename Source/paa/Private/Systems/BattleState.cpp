@@ -0,0 +1,74 @@
+#include "Systems/BattleState.h"
+
+void FBattleState::Reset(const FGridData& InGrid)
+{
+	Grid.Init(InGrid.SizeX, InGrid.SizeY);
+	Grid.Tiles.Empty(); // Simulations never touch the tile actors.
+	SetTerrain(InGrid);
+
+	Occupied.Init(false, Grid.Num());
+	Units = FBattleUnits();
+	bPlayerTurn = true;
+}
+
+void FBattleState::SetTerrain(const FGridData& InGrid)
+{
+	check(InGrid.Num() == Grid.Num());
+
+	Grid.Obstacles = InGrid.Obstacles;
+	Grid.SetMovementCosts(InGrid.IsUniformCost() ? TArray<uint8>() : InGrid.MovementCost);
+
+	// Copies of the state keep sharing the old cache; this state gets a fresh one.
+	const TSharedRef<FGridVisibility> NewVisibility = MakeShared<FGridVisibility>();
+	NewVisibility->Build(Grid, FGridVisibility::MaxRange);
+	Visibility = NewVisibility;
+}
+
+bool FBattleState::HasLineOfSight(const FGridCoord& From, const FGridCoord& To) const
+{
+	return Visibility ? Visibility->IsVisible(Grid, From, To) : FGridVisibility::HasLineOfSight(Grid, From, To);
+}
+
+void FBattleState::AddVisibleArea(const FGridCoord& Center, const int32 Range, FGridBitboard& InOutArea) const
+{
+	if (Visibility) Visibility->AddVisibleArea(Grid, Center, Range, InOutArea);
+	else FGridVisibility().AddVisibleArea(Grid, Center, Range, InOutArea);
+}
+
+int32 FBattleState::AddUnit(const FBattleUnitDesc& Desc)
+{
+	Units.Type.Add(Desc.Type);
+	Units.PlayerTeam.Add(Desc.bPlayerTeam);
+	Units.Position.Add(Desc.Position);
+	Units.LifePoints.Add(Desc.LifePoints);
+	Units.MovementRange.Add(Desc.MovementRange);
+	Units.AttackRange.Add(Desc.AttackRange);
+	Units.DamageMin.Add(Desc.DamageMin);
+	Units.DamageMax.Add(Desc.DamageMax);
+	const int32 Index = Units.Action.Add(EActionType::None);
+
+	if (const int32 Cell = Grid.ToIndex(Desc.Position); Cell != INDEX_NONE) Occupied[Cell] = true;
+
+	return Index;
+}
+
+int32 FBattleState::FindUnitAt(const FGridCoord& Tile) const
+{
+	// Battles hold a handful of units, so a scan is cheaper than keeping a per-cell index in every copy.
+	for (int32 Unit = 0; Unit < Units.Num(); ++Unit)
+	{
+		if (Units.IsAlive(Unit) && Units.Position[Unit] == Tile) return Unit;
+	}
+
+	return INDEX_NONE;
+}
+
+bool FBattleState::IsTeamDefeated(const bool bPlayerTeam) const
+{
+	for (int32 Unit = 0; Unit < Units.Num(); ++Unit)
+	{
+		if (Units.IsPlayer(Unit) == bPlayerTeam && Units.IsAlive(Unit)) return false;
+	}
+
+	return true;
+}
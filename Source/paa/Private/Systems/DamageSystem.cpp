@@ -1,33 +1,10 @@
 #include "Systems/DamageSystem.h"
 
-#include "Units/BrawlerUnit.h"
-
-TPair<int32, int32> UDamageSystem::ApplyDamage(const TWeakObjectPtr<ABaseUnit> Attacker, const TWeakObjectPtr<ABaseUnit> Defender)
+void UDamageSystem::ApplyDamage(const TWeakObjectPtr<ABaseUnit> Attacker, const TWeakObjectPtr<ABaseUnit> Defender, const FBattleAttackResult& Result)
 {
-	const int32 Damage = Attacker->GetDamage();
-	int32 DamageCounter = -1;
-	
 	// Apply damage to the defender.
-	Defender->GetDamaged(Damage);
-
-	// Handle counter-attack logic for sniper units.
-	if (ASniperUnit* Sniper = Cast<ASniperUnit>(Attacker))
-	{
-		if (const ABrawlerUnit* Brawler = Cast<ABrawlerUnit>(Defender); Brawler && !Sniper->IsNeighbour(Brawler->GetPosition())) 
-			return TPair<int32, int32>(Damage, DamageCounter);
-		
-		DamageCounter = ApplyCounterAttack(Sniper);
-	}
+	if (Defender.IsValid() && Result.Damage > 0) Defender->GetDamaged(Result.Damage);
 
-	return TPair<int32, int32>(Damage, DamageCounter);
+	// Apply the counter-attack damage to the attacker.
+	if (Attacker.IsValid() && Result.CounterDamage > 0) Attacker->GetDamaged(Result.CounterDamage);
 }
-
-int32 UDamageSystem::ApplyCounterAttack(const TWeakObjectPtr<ASniperUnit> Attacker)
-{
-	// Apply a random amount of counter-attack damage to the sniper.
-	const int32 Damage = FMath::RandRange(1, 3);
-	
-	Attacker->GetDamaged(Damage);
-
-	return Damage;
-}
\ No newline at end of file
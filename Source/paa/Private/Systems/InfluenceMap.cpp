@@ -0,0 +1,168 @@
+#include "Systems/InfluenceMap.h"
+
+void FInfluenceMap::Build(const FBattleState& State, const bool bInPlayerTeam)
+{
+	const FBattleUnits& Units = State.Units;
+	bPlayerTeam = bInPlayerTeam;
+	SizeX = State.Grid.SizeX;
+
+	Threat.Init(0, State.Grid.Num());
+	Support.Init(0, State.Grid.Num());
+	Enemies.Init(false, Units.Num());
+	Stamped.Init(FGridCoord(), Units.Num());
+	ThreatCells.SetNum(Units.Num());
+
+	for (int32 Unit = 0; Unit < Units.Num(); ++Unit)
+	{
+		Enemies[Unit] = Units.IsPlayer(Unit) != bPlayerTeam;
+		ThreatCells[Unit].Reset();
+
+		if (!Units.IsAlive(Unit)) continue;
+
+		Stamped[Unit] = Units.Position[Unit];
+		if (Enemies[Unit]) StampThreat(State, Unit);
+		else StampSupport(State.Grid, Units.Position[Unit], 1);
+	}
+
+	BuildTargetDistance(State);
+}
+
+void FInfluenceMap::UpdateUnit(const FBattleState& State, const int32 Unit)
+{
+	check(IsBuilt() && Stamped.IsValidIndex(Unit));
+
+	const FBattleUnits& Units = State.Units;
+	const bool bAlive = Units.IsAlive(Unit);
+
+	// Still stamped where it stands (or already taken off the map if it died).
+	if (bAlive ? Stamped[Unit] == Units.Position[Unit] : !Stamped[Unit].IsSet()) return;
+
+	// Take the old stamp back.
+	if (Stamped[Unit].IsSet())
+	{
+		if (Enemies[Unit])
+		{
+			const int32 Damage = Units.DamageMin[Unit] + Units.DamageMax[Unit];
+			for (const int32 Cell : ThreatCells[Unit]) Threat[Cell] -= Damage;
+			ThreatCells[Unit].Reset();
+		}
+		else
+		{
+			StampSupport(State.Grid, Stamped[Unit], -1);
+		}
+	}
+
+	// Stamp the unit where it stands now, if it is still alive.
+	Stamped[Unit] = bAlive ? Units.Position[Unit] : FGridCoord();
+	if (bAlive)
+	{
+		if (Enemies[Unit]) StampThreat(State, Unit);
+		else StampSupport(State.Grid, Units.Position[Unit], 1);
+	}
+
+	if (Enemies[Unit]) BuildTargetDistance(State);
+}
+
+int32 FInfluenceMap::GetSupport(const int32 Cell, const int32 ExcludeUnit) const
+{
+	int32 Value = Support[Cell];
+
+	// Take the excluded ally's share back out of the sum.
+	if (ExcludeUnit != INDEX_NONE && !Enemies[ExcludeUnit] && Stamped[ExcludeUnit].IsSet())
+	{
+		const int32 Distance = Stamped[ExcludeUnit].Distance(FGridCoord(Cell % SizeX, Cell / SizeX));
+		Value -= FMath::Max(0, SupportRadius + 1 - Distance);
+	}
+
+	return Value;
+}
+
+TConstArrayView<int32> FInfluenceMap::GetLayer(const EInfluenceLayer Layer) const
+{
+	switch (Layer)
+	{
+	case EInfluenceLayer::Threat: return Threat;
+	case EInfluenceLayer::Support: return Support;
+	default: return TargetDistance;
+	}
+}
+
+void FInfluenceMap::StampThreat(const FBattleState& State, const int32 Unit)
+{
+	const FBattleUnits& Units = State.Units;
+
+	// Every tile the enemy could walk to this turn, then every tile it could shoot from one of them.
+	const FGridBitboard& Reach = UPathfindingUtilities::GetReach(State.Grid, State.Grid.ToIndex(Units.Position[Unit]), Units.MovementRange[Unit], State.Occupied, Flood);
+
+	Strike.Init(State.Grid.SizeX, State.Grid.SizeY);
+	Reach.ForEachSetBit([this, &State, &Units, Unit](const FGridCoord& Tile)
+	{
+		State.AddVisibleArea(Tile, Units.AttackRange[Unit], Strike);
+	});
+
+	const int32 Damage = Units.DamageMin[Unit] + Units.DamageMax[Unit];
+	TArray<int32>& Cells = ThreatCells[Unit];
+
+	Strike.ForEachSetBit([this, &State, &Cells, Damage](const FGridCoord& Tile)
+	{
+		const int32 Cell = State.Grid.ToIndex(Tile);
+		Threat[Cell] += Damage;
+		Cells.Add(Cell);
+	});
+}
+
+void FInfluenceMap::StampSupport(const FGridData& Grid, const FGridCoord& Center, const int32 Sign)
+{
+	// A diamond kernel: full weight on the ally's tile, fading by one per step.
+	for (int32 OffsetY = -SupportRadius; OffsetY <= SupportRadius; ++OffsetY)
+	{
+		const int32 Reach = SupportRadius - FMath::Abs(OffsetY);
+
+		for (int32 OffsetX = -Reach; OffsetX <= Reach; ++OffsetX)
+		{
+			const int32 Cell = Grid.ToIndex(FGridCoord(Center.X + OffsetX, Center.Y + OffsetY));
+			if (Cell != INDEX_NONE) Support[Cell] += Sign * (SupportRadius + 1 - FMath::Abs(OffsetX) - FMath::Abs(OffsetY));
+		}
+	}
+}
+
+void FInfluenceMap::BuildTargetDistance(const FBattleState& State)
+{
+	const FGridData& Grid = State.Grid;
+	const FBattleUnits& Units = State.Units;
+
+	TargetDistance.Init(INDEX_NONE, Grid.Num());
+
+	// Dijkstra seeded with every living enemy; units move, so they do not block the way.
+	Queue.Begin(Grid.MaxMovementCost);
+	for (int32 Unit = 0; Unit < Units.Num(); ++Unit)
+	{
+		const int32 Cell = Grid.ToIndex(Units.Position[Unit]);
+		if (!Enemies[Unit] || !Units.IsAlive(Unit) || Cell == INDEX_NONE || TargetDistance[Cell] == 0) continue;
+
+		TargetDistance[Cell] = 0;
+		Queue.Push(Cell, 0);
+	}
+
+	int32 Current;
+	int32 CurrentDistance;
+	while (Queue.Pop(Current, CurrentDistance))
+	{
+		// Skip entries superseded by a cheaper one.
+		if (CurrentDistance != TargetDistance[Current]) continue;
+
+		int32 Neighbors[4];
+		const int32 NeighborCount = Grid.GetNeighbors(Current, Neighbors);
+
+		for (int32 i = 0; i < NeighborCount; ++i)
+		{
+			const int32 Neighbor = Neighbors[i];
+			const int32 NextDistance = CurrentDistance + Grid.MovementCost[Neighbor];
+
+			if (Grid.IsObstacle(Neighbor) || (TargetDistance[Neighbor] != INDEX_NONE && TargetDistance[Neighbor] <= NextDistance)) continue;
+
+			TargetDistance[Neighbor] = NextDistance;
+			Queue.Push(Neighbor, NextDistance);
+		}
+	}
+}
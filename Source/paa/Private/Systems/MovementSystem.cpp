@@ -1,8 +1,34 @@
 #include "Systems/MovementSystem.h"
 
+#include "Grid/GridManager.h"
+
 void UMovementSystem::ApplyMovement(const TWeakObjectPtr<ABaseUnit> Mover,
-	const FString& EndTile, const TArray<FString>& OccupiedTiles)
+	const FGridCoord& EndTile, const TBitArray<>& Occupied, const AGridManager* GridManager)
 {
+	const FGridCoord StartTile = Mover->GetPosition();
+
 	// Moves the unit along the path to the end tile, avoiding occupied tiles.
-	Mover->FollowPath(EndTile, OccupiedTiles);
-}
\ No newline at end of file
+	Mover->FollowPath(EndTile, Occupied);
+
+	// The unit left its tile and now holds the end tile, so fields around both are stale.
+	if (GridManager && Mover->GetPosition() != StartTile)
+	{
+		GridManager->NotifyOccupancyChanged(StartTile);
+		GridManager->NotifyOccupancyChanged(EndTile);
+	}
+}
+
+void UMovementSystem::ApplyMovement(const TWeakObjectPtr<ABaseUnit> Mover, TArray<FGridCoord>&& Path, const AGridManager* GridManager)
+{
+	const FGridCoord StartTile = Mover->GetPosition();
+
+	// Moves the unit along the given path.
+	Mover->FollowPath(MoveTemp(Path));
+
+	// The unit left its tile and now holds the end tile, so fields around both are stale.
+	if (GridManager && Mover->GetPosition() != StartTile)
+	{
+		GridManager->NotifyOccupancyChanged(StartTile);
+		GridManager->NotifyOccupancyChanged(Mover->GetPosition());
+	}
+}
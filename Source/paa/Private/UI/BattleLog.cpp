@@ -0,0 +1,54 @@
+#include "UI/BattleLog.h"
+
+#include "Blueprint/WidgetTree.h"
+
+FString UBattleLogItem::Describe(const FBattleActionRecord& Record, const bool bCounterAttack, const AGridManager* GridManager)
+{
+	const auto TileName = [GridManager](const FGridCoord& Tile) { return GridManager ? GridManager->GetTileName(Tile) : FString(); };
+	const auto TypeName = [](const EUnitTypes Type) { return Type == EUnitTypes::Brawler ? TEXT("B ") : TEXT("S "); };
+
+	FString Text = Record.bPlayerTeam ? TEXT("HP: ") : TEXT("AI: ");
+	Text += TypeName(Record.UnitType);
+
+	if (bCounterAttack)
+	{
+		Text += TileName(Record.From) + TEXT(" GOT COUNTERED BY ");
+		Text += TypeName(Record.TargetType);
+		Text += TileName(Record.To) + TEXT(" ") + FString::FromInt(Record.CounterDamage);
+	}
+	else if (Record.Kind == EBattleActionKind::Attack)
+	{
+		Text += TileName(Record.To) + TEXT(" ") + FString::FromInt(Record.Damage); // The attacked tile and the damage.
+	}
+	else
+	{
+		Text += TileName(Record.From) + TEXT(" -> ") + TileName(Record.To); // The move.
+	}
+
+	return Text;
+}
+
+void UBattleLogEntry::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (TextBlock_Event || !WidgetTree || WidgetTree->RootWidget) return;
+
+	// Styled like the rows the log used to add to its scroll box.
+	TextBlock_Event = WidgetTree->ConstructWidget<UTextBlock>(UTextBlock::StaticClass(), TEXT("TextBlock_Event"));
+	TextBlock_Event->SetColorAndOpacity(FSlateColor(FLinearColor::Black));
+	TextBlock_Event->SetJustification(ETextJustify::Left);
+	TextBlock_Event->SetAutoWrapText(true);
+	WidgetTree->RootWidget = TextBlock_Event;
+}
+
+void UBattleLogEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	IUserObjectListEntry::NativeOnListItemObjectSet(ListItemObject);
+
+	// Entries are recycled across rows, so every field is set again for the new item.
+	if (const UBattleLogItem* Item = Cast<UBattleLogItem>(ListItemObject); Item && TextBlock_Event)
+	{
+		TextBlock_Event->SetText(FText::FromString(Item->GetText()));
+	}
+}
@@ -1,8 +1,33 @@
 #include "UI/BattleUI.h"
 
+#include "Blueprint/WidgetTree.h"
+#include "Components/PanelWidget.h"
 #include "Game/Managers/BattleManager.h"
+#include "Game/Managers/UnitVisualsManager.h"
 #include "Storage/Nodes/FileEntry.h"
 
+void UBattleUI::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (ListView_Events || !ScrollBox_Events) return;
+
+	// The entry class is only exposed to the designer, so it is set through reflection like a blueprint default.
+	UPanelWidget* Parent = ScrollBox_Events->GetParent();
+	FClassProperty* EntryClass = FindFProperty<FClassProperty>(UListViewBase::StaticClass(), TEXT("EntryWidgetClass"));
+	if (!Parent || !EntryClass)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ScrollBox_Events cannot be replaced by the event list!"));
+		return;
+	}
+
+	// The layout only has a scroll box, so a list view takes over its slot before the Slate widgets are built.
+	ListView_Events = WidgetTree->ConstructWidget<UListView>(UListView::StaticClass(), TEXT("ListView_Events"));
+	EntryClass->SetObjectPropertyValue_InContainer(ListView_Events, UBattleLogEntry::StaticClass());
+	Parent->ReplaceChildAt(Parent->GetChildIndex(ScrollBox_Events), ListView_Events);
+	ScrollBox_Events = nullptr;
+}
+
 void UBattleUI::NativeConstruct()
 {
 	Super::NativeConstruct();
@@ -39,10 +64,7 @@ void UBattleUI::NativeConstruct()
 		bEndSignal = false;
 	}
 
-	if (ScrollBox_Events)
-	{
-		ScrollBox_Events->ClearChildren();
-	}
+	ClearLog();
 }
 
 void UBattleUI::Init(TWeakObjectPtr<AStrategyGameMode> NewGameMode)
@@ -53,43 +75,16 @@ void UBattleUI::Init(TWeakObjectPtr<AStrategyGameMode> NewGameMode)
 	{
 		GameMode->OnSwitchTurn.RemoveDynamic(this, &UBattleUI::OnSwitchTurn);
 		GameMode->GetBattleManager()->OnUnitSelected.RemoveDynamic(this, &UBattleUI::OnUnitSelected);
-		GameMode->GetBattleManager()->OnActionExecuted.RemoveDynamic(this, &UBattleUI::OnActionExecuted);
+		GameMode->GetBattleManager()->OnBattleAction.RemoveAll(this);
 		GameMode->GetBattleManager()->OnCanSkipTurn.RemoveDynamic(this, &UBattleUI::OnCanSkipTurn);
 		GameMode->GetBattleManager()->OnCanEnd.RemoveDynamic(this, &UBattleUI::OnCanEnd);
 
 		GameMode->OnSwitchTurn.AddDynamic(this, &UBattleUI::OnSwitchTurn);
 		GameMode->GetBattleManager()->OnUnitSelected.AddDynamic(this, &UBattleUI::OnUnitSelected);
-		GameMode->GetBattleManager()->OnActionExecuted.AddDynamic(this, &UBattleUI::OnActionExecuted);
+		GameMode->GetBattleManager()->OnBattleAction.AddUObject(this, &UBattleUI::OnBattleAction);
 		GameMode->GetBattleManager()->OnCanSkipTurn.AddDynamic(this, &UBattleUI::OnCanSkipTurn);
 		GameMode->GetBattleManager()->OnCanEnd.AddDynamic(this, &UBattleUI::OnCanEnd);
 	}
-
-	TArray<FString> TexturePaths = {
-		TEXT("/Game/Textures/Units/Soldier1_Blue.Soldier1_Blue"),
-		TEXT("/Game/Textures/Units/Soldier1_Brown.Soldier1_Brown"),
-		TEXT("/Game/Textures/Units/Soldier1_Green.Soldier1_Green"),
-		TEXT("/Game/Textures/Units/Soldier1_Red.Soldier1_Red"),
-		TEXT("/Game/Textures/Units/Soldier1_Violet.Soldier1_Violet"),
-		TEXT("/Game/Textures/Units/Soldier2_Blue.Soldier2_Blue"),
-		TEXT("/Game/Textures/Units/Soldier2_Brown.Soldier2_Brown"),
-		TEXT("/Game/Textures/Units/Soldier2_Green.Soldier2_Green"),
-		TEXT("/Game/Textures/Units/Soldier2_Red.Soldier2_Red"),
-		TEXT("/Game/Textures/Units/Soldier2_Violet.Soldier2_Violet")
-	};
-
-	// Carica ogni texture e aggiungila all'array
-	for (const FString& Path : TexturePaths)
-	{
-		UTexture2D* Texture = LoadObject<UTexture2D>(nullptr, *Path);
-		if (Texture)
-		{
-			Textures.Add(Texture);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Failed to load texture: %s"), *Path);
-		}
-	}
 }
 
 void UBattleUI::OnHelpButtonClicked()
@@ -155,7 +150,7 @@ void UBattleUI::OnUnitSelected(ABaseUnit* Unit, bool bIsPlayerUnit)
 
         FString Max = "/" + FString::FromInt(Unit->GetMaxLifePoint());
 
-        FString Position = "Position: " + Unit->GetPosition();
+        FString Position = "Position: " + GameMode->GetGridManager()->GetTileName(Unit->GetPosition());
 
         if (TextBlock_UnitBelonging) TextBlock_UnitBelonging->SetText(FText::FromString(Belonging));
         if (TextBlock_UnitType) TextBlock_UnitType->SetText(FText::FromString(Type));
@@ -175,8 +170,12 @@ void UBattleUI::OnUnitSelected(ABaseUnit* Unit, bool bIsPlayerUnit)
 
 		if (Image_UnitSelected)
 		{
-			const int32 Index = bIsBrawler * 5 + Unit->GetTextureColor();
-			Image_UnitSelected->SetBrushFromTexture(Textures[Index].Get(), false);
+			// The textures were streamed in during the begin phase; nothing is loaded here.
+			const EUnitTypes UnitType = bIsBrawler ? EUnitTypes::Brawler : EUnitTypes::Sniper;
+			if (UTexture2D* Texture = GameMode->GetUnitVisualsManager()->GetTexture(UnitType, Unit->GetTextureColor()))
+			{
+				Image_UnitSelected->SetBrushFromTexture(Texture, false);
+			}
 		}
 		else
 		{
@@ -189,27 +188,45 @@ void UBattleUI::OnUnitSelected(ABaseUnit* Unit, bool bIsPlayerUnit)
 	}
 }
 
-void UBattleUI::OnActionExecuted(const FString Text)
+void UBattleUI::OnBattleAction(const FBattleActionRecord& Record)
 {
-	if (ScrollBox_Events)
-	{
-		// Create a new UTextBlock
-		UTextBlock* NewTextBlock = NewObject<UTextBlock>(this);
-		NewTextBlock->SetText(FText::FromString(Text));
-		NewTextBlock->SetColorAndOpacity(FSlateColor(FLinearColor::Black));
-		NewTextBlock->SetJustification(ETextJustify::Left);
-		NewTextBlock->SetAutoWrapText(true);
-
-		// Add the new UTextBlock to the ScrollBox
-		ScrollBox_Events->AddChild(NewTextBlock);
-
-		// Scroll to the bottom
-		ScrollBox_Events->ScrollToEnd();
-	}
-	else
+	AddLogRow(Record, false);
+	if (Record.WasCountered()) AddLogRow(Record, true);
+}
+
+void UBattleUI::AddLogRow(const FBattleActionRecord& Record, const bool bCounterAttack)
+{
+	if (!ListView_Events)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ScrollBox_Events is not valid!"));
+		UE_LOG(LogTemp, Warning, TEXT("ListView_Events is not valid!"));
+		return;
 	}
+
+	// Once the ring is full the oldest row becomes the newest, so the log never holds more than MaxLogEntries rows.
+	const int32 NumRows = LogItems.Num();
+	const bool bFull = NumRows >= MaxLogEntries;
+	const int32 Slot = bFull ? LogHead : NumRows;
+	if (bFull) LogHead = (LogHead + 1) % NumRows;
+
+	if (!bFull) LogItems.Add(NewObject<UBattleLogItem>(this));
+
+	UBattleLogItem* Item = LogItems[Slot];
+	if (bFull) ListView_Events->RemoveItem(Item);
+	Item->Record = Record;
+	Item->bCounterAttack = bCounterAttack;
+	Item->GridManager = GameMode.IsValid() ? GameMode->GetGridManager() : nullptr;
+
+	// Only the visible rows have entry widgets; they format their items when the list refreshes.
+	ListView_Events->AddItem(Item);
+	ListView_Events->ScrollToBottom();
+}
+
+void UBattleUI::ClearLog()
+{
+	if (ListView_Events) ListView_Events->ClearListItems();
+
+	LogItems.Reset();
+	LogHead = 0;
 }
 
 void UBattleUI::OnCanSkipTurn(const bool bCanSkipTurn)
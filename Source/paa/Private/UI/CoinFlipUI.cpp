@@ -66,7 +66,7 @@ void UCoinFlipUI::UpdateDots()
 
 void UCoinFlipUI::RandomBool()
 {
-	RandomValue = FMath::RandBool();
+	RandomValue = GameMode->GetRandomStream(ERandomStream::CoinFlip).RandBool();
 	const FString RandomBoolUser = FString(RandomValue ? "PLAYER" : "AI");
 
 	const FString RandomBoolString = FString(RandomBoolUser + "\n TURN");
@@ -2,6 +2,7 @@
 
 #include "Game/StrategyGameMode.h"
 #include "Game/Managers/PlacementManager.h"
+#include "Game/Managers/UnitVisualsManager.h"
 #include "Components/Button.h"
 
 void UPlacementUI::NativeConstruct()
@@ -40,31 +41,11 @@ void UPlacementUI::Init(TWeakObjectPtr<AStrategyGameMode> NewGameMode)
 		GameMode->GetPlacementManager()->OnUnitPlaced.AddDynamic(this, &UPlacementUI::OnUnitPlaced);
 	}
 
-	TArray<FString> TexturePaths = {
-		TEXT("/Game/Textures/Units/Soldier1_Blue.Soldier1_Blue"),
-		/*TEXT("/Game/Textures/Units/Soldier1_Brown.Soldier1_Brown"),
-		TEXT("/Game/Textures/Units/Soldier1_Green.Soldier1_Green"),
-		TEXT("/Game/Textures/Units/Soldier1_Red.Soldier1_Red"),
-		TEXT("/Game/Textures/Units/Soldier1_Violet.Soldier1_Violet"),*/
-		TEXT("/Game/Textures/Units/Soldier2_Blue.Soldier2_Blue"),
-		/*TEXT("/Game/Textures/Units/Soldier2_Brown.Soldier2_Brown"),
-		TEXT("/Game/Textures/Units/Soldier2_Green.Soldier2_Green"),
-		TEXT("/Game/Textures/Units/Soldier2_Red.Soldier2_Red"),
-		TEXT("/Game/Textures/Units/Soldier2_Violet.Soldier2_Violet")*/
-	};
-
-	// Carica ogni texture e aggiungila all'array
-	for (const FString& Path : TexturePaths)
+	// The textures may still be streaming in when a unit type is picked; its image is filled in once they are.
+	if (GameMode.IsValid() && GameMode->GetUnitVisualsManager())
 	{
-		UTexture2D* Texture = LoadObject<UTexture2D>(nullptr, *Path);
-		if (Texture)
-		{
-			Textures.Add(Texture);
-		}
-		else
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Failed to load texture: %s"), *Path);
-		}
+		GameMode->GetUnitVisualsManager()->OnVisualsReady.RemoveDynamic(this, &UPlacementUI::OnUnitVisualsReady);
+		GameMode->GetUnitVisualsManager()->OnVisualsReady.AddDynamic(this, &UPlacementUI::OnUnitVisualsReady);
 	}
 }
 
@@ -95,10 +76,8 @@ void UPlacementUI::OnSniperButtonClicked()
 		if (TextBlock_Remaining) TextBlock_Remaining->SetText(FText::FromString(Remaining));
 		if (TextBlock_Max) TextBlock_Max->SetText(FText::FromString(Max));
 
-		if (Image_UnitSelected)
-		{
-			Image_UnitSelected->SetBrushFromTexture(Textures[0].Get(), false);
-		}
+		ShownUnitType = EUnitTypes::Sniper;
+		ShowUnitTexture();
 	}
 }
 
@@ -129,13 +108,26 @@ void UPlacementUI::OnBrawlerButtonClicked()
 		if (TextBlock_Remaining) TextBlock_Remaining->SetText(FText::FromString(Remaining));
 		if (TextBlock_Max) TextBlock_Max->SetText(FText::FromString(Max));
 
-		if (Image_UnitSelected)
-		{
-			Image_UnitSelected->SetBrushFromTexture(Textures[1].Get(), false);
-		}
+		ShownUnitType = EUnitTypes::Brawler;
+		ShowUnitTexture();
 	}
 }
 
+void UPlacementUI::ShowUnitTexture()
+{
+	if (!Image_UnitSelected || ShownUnitType == EUnitTypes::None || !GameMode.IsValid()) return;
+
+	if (UTexture2D* Texture = GameMode->GetUnitVisualsManager()->GetTexture(ShownUnitType, 0))
+	{
+		Image_UnitSelected->SetBrushFromTexture(Texture, false);
+	}
+}
+
+void UPlacementUI::OnUnitVisualsReady()
+{
+	ShowUnitTexture();
+}
+
 void UPlacementUI::OnUnitPlaced(EUnitTypes UnitType)
 {
 	switch (UnitType)
@@ -14,6 +14,7 @@ ABaseUnit::ABaseUnit()
 	if (UnitMesh)
 	{
 		RootComponent = UnitMesh;
+		UnitMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision); // Units are picked through the tile they stand on.
 	}
 	else
 	{
@@ -100,7 +101,6 @@ void ABaseUnit::Tick(float DeltaTime)
 			}
 			
 			SetActorLocation(NewLocation);
-			UnitPosition = GridSystem->WorldToGrid(NewLocation);
 		}
 	}
 }
@@ -115,7 +115,7 @@ void ABaseUnit::SetTextureColor(const int32 ColorIndex)
 	}
 }
 
-void ABaseUnit::SetUnitPosition(const FString& NewUnitPosition)
+void ABaseUnit::SetUnitPosition(const FGridCoord& NewUnitPosition)
 {
 	UnitPosition = NewUnitPosition;
 
@@ -138,14 +138,14 @@ int32 ABaseUnit::GetTextureColor() const
 	return TextureIndex;
 }
 
-FString ABaseUnit::GetPosition() const
+FGridCoord ABaseUnit::GetPosition() const
 {
 	return UnitPosition;
 }
 
-bool ABaseUnit::IsNeighbour(const FString& TileName) const
+bool ABaseUnit::IsNeighbour(const FGridCoord& Tile) const
 {
-	return GridSystem->GetNeighbours(UnitPosition).Contains(TileName);
+	return UnitPosition.Distance(Tile) == 1;
 }
 
 int32 ABaseUnit::GetMovementRange() const
@@ -183,21 +183,30 @@ int32 ABaseUnit::GetMinDamage() const
 	return DamageMin;
 }
 
-int32 ABaseUnit::GetDamage() const
-{
-	return FMath::RandRange(DamageMin, DamageMax);
-}
-
 /*void ABaseUnit::FollowPath(const FString& EndTile)
 {
 	CurrentPath = GridManager->FindPath(UnitPosition, EndTile);
 	CurrentPathIndex = 0;
 }*/
 
-void ABaseUnit::FollowPath(const FString& EndTile, const TArray<FString>& OccupiedTiles)
+void ABaseUnit::FollowPath(const FGridCoord& EndTile, const TBitArray<>& Occupied)
+{
+	CurrentPath = GridSystem->FindPath(UnitPosition, EndTile, Occupied);
+	CurrentPathIndex = 0;
+
+	// The unit logically holds its destination as soon as it sets off; Tick only animates the actor.
+	if (CurrentPath.Num() > 0) UnitPosition = EndTile;
+}
+
+void ABaseUnit::FollowPath(TArray<FGridCoord>&& Path)
 {
-	CurrentPath = GridSystem->FindPath(UnitPosition, EndTile, OccupiedTiles);
+	check(Path.Num() == 0 || Path[0] == UnitPosition);
+
+	CurrentPath = MoveTemp(Path);
 	CurrentPathIndex = 0;
+
+	// The unit logically holds its destination as soon as it sets off; Tick only animates the actor.
+	if (CurrentPath.Num() > 0) UnitPosition = CurrentPath.Last();
 }
 
 void ABaseUnit::GetDamaged(const int32 Damage)
@@ -4,7 +4,7 @@ ABrawlerUnit::ABrawlerUnit()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
-	UnitPosition = "A1";
+	UnitPosition = FGridCoord(0, 0);
 	MovementRange = 6;
 	AttackType = EAttackType::Melee;
 	AttackRange = 1;
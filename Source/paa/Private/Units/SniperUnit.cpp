@@ -4,7 +4,7 @@ ASniperUnit::ASniperUnit()
 {
 	PrimaryActorTick.bCanEverTick = true;
 	
-	UnitPosition = "A1";
+	UnitPosition = FGridCoord(0, 0);
 	MovementRange = 3;
 	AttackType = EAttackType::Ranged;
 	AttackRange = 10;
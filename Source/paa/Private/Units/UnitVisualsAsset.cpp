@@ -0,0 +1,6 @@
+#include "Units/UnitVisualsAsset.h"
+
+const TArray<TSoftObjectPtr<UTexture2D>>& UUnitVisualsAsset::GetTextures(const EUnitTypes Type) const
+{
+	return Type == EUnitTypes::Brawler ? BrawlerTextures : SniperTextures;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/BattleState.h"
+#include "Systems/InfluenceMap.h"
+
+// Forward Declarations
+class ABaseUnit;
+class UBattleManager;
+
+/**
+ * FPlannedAction is what one AI unit should do this turn: an optional move followed by an optional attack.
+ */
+struct PAA_API FPlannedAction
+{
+	int32 UnitIndex = INDEX_NONE; // Index of the acting unit in the battle state.
+	FGridCoord MoveTo; // The tile to move to, or an unset coordinate to stay.
+	int32 TargetIndex = INDEX_NONE; // Index of the attacked unit in the battle state, or INDEX_NONE for no attack.
+};
+
+/**
+ * FAITurnPlan is the full plan of an AI turn, replayed action by action by the AI controller.
+ */
+struct PAA_API FAITurnPlan
+{
+	TArray<FPlannedAction> Actions; // One action per AI unit, in the order they should be played.
+	double PlanningSeconds = 0.0; // Wall time spent planning.
+	int64 Iterations = 0; // Number of simulated turns, summed over every worker.
+	int64 Nodes = 0; // Number of search tree nodes created, summed over every worker.
+};
+
+/**
+ * FAIPlannerSettings configures a search.
+ */
+struct PAA_API FAIPlannerSettings
+{
+	double BudgetSeconds = 0.25; // Wall time the search may use.
+	int32 IterationsPerWorker = 0; // If positive, each tree runs exactly this many iterations instead of using the time budget.
+	int32 NumWorkers = 1; // Number of independent search trees, each on its own worker thread.
+	uint32 Seed = 0; // Seed of the workers' random streams; worker N draws from sequence N.
+};
+
+/**
+ * FAITurnPlanner searches the AI turn with Monte Carlo tree search on the headless battle rules.
+ * Each tree level decides the move and attack of one AI unit. The search is open-loop: every iteration replays
+ * the action sequence from the root with freshly rolled damage, so the value of a sequence averages over the
+ * random damage and counter-attacks instead of trusting a single outcome. Workers grow independent trees
+ * until the time budget (or their fixed iteration count) runs out; their statistics are then merged and the most visited sequence is played.
+ */
+struct PAA_API FAITurnPlanner
+{
+	/**
+	 * Copies the battle state the planner searches on. Must be called on the game thread.
+	 * The copy's random stream is reseeded, so the search cannot foresee the damage the game will roll.
+	 * @param BattleManager - The battle.
+	 * @param Seed - The seed of the copy's random stream.
+	 * @param OutHandles - Receives the unit actors, indexed like the state's units (nullptr for dead units).
+	 * @return The battle state, with the AI's team acting.
+	 */
+	static FBattleState Capture(const UBattleManager& BattleManager, const uint32 Seed, TArray<TWeakObjectPtr<ABaseUnit>>& OutHandles);
+
+	/**
+	 * Plans the AI turn. Safe to call from any thread; the workers run with ParallelFor.
+	 * With a fixed iteration count and worker count the plan only depends on the state, the influence map and the seed.
+	 * @param State - The battle state to plan on.
+	 * @param Influence - The acting team's influence map of the state, ranking where units should go;
+	 *                    built from the state here if it is not built for the acting team.
+	 * @param Settings - The search budget and parallelism.
+	 * @return The plan and the search statistics.
+	 */
+	static FAITurnPlan Plan(const FBattleState& State, const FInfluenceMap& Influence, const FAIPlannerSettings& Settings);
+};
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Game/StrategyGameMode.h"
 #include "Units/BaseUnit.h"
+#include "Game/Managers/BattleManager.h"
+#include "Game/Controllers/AITurnPlanner.h"
 #include "GameAIController.generated.h"
 
 UENUM()
@@ -35,9 +37,19 @@ private:
 
 	/**
 	 * @brief Handles decisions and logic during the battle phase of the game
+	 * 
+	 * Captures a copy of the battle state and searches the turn on worker threads within the planning budget
+	 * (paa.AI.PlanningBudgetMs); the game thread keeps running meanwhile.
 	 */
 	void HandleBattlePhase();
 
+	/**
+	 * @brief Starts replaying a finished turn plan, called on the game thread once planning completes
+	 * 
+	 * @param Plan The plan computed from the state captured in HandleBattlePhase
+	 */
+	void OnPlanReady(FAITurnPlan&& Plan);
+
 	// -------------------- Event Handlers --------------------
 	/**
 	 * @brief Handles changes in game phase by updating internal state and executing appropriate logic
@@ -73,18 +85,26 @@ private:
 	EBattleState BattleState;
 
 	/**
-	 * @brief Current Unit being processed in battle 
+	 * @brief Current planned action being processed in battle (its move in the Movement state, then its attack in the Attack state)
 	 */
 	int32 CurrentUnitIndex;
+
+	/**
+	 * @brief The plan of the current turn
+	 */
+	FAITurnPlan CurrentPlan;
+
+	/**
+	 * @brief The unit actors of the state the plan was computed on, indexed like the state's units
+	 */
+	TArray<TWeakObjectPtr<ABaseUnit>> PlannedUnits;
 	
 	void ProcessNextAction();
 	void ProcessMovement(UBattleManager* BattleManager, AGridManager* GridManager);
 	void ProcessAttack(UBattleManager* BattleManager, AGridManager* GridManager);
 	
 	// --------------------- Internal Helpers -------------------
-	void TryMove(const UBattleManager* BattleManager, const AGridManager* GridManager, ABaseUnit* AIUnit);
-	void TryAttack(const UBattleManager* BattleManager, const AGridManager* GridManager, ABaseUnit* AIUnit);
-
-	static ABaseUnit* FindNearestPlayerUnit(const ABaseUnit* AIUnit, const TArray<TWeakObjectPtr<ABaseUnit>>& PlayerUnits, const AGridManager* GridManager);	
-	static FString FindBestMovementTile(const ABaseUnit* AIUnit, const TArray<FString>& MovementTiles, const ABaseUnit* TargetPlayer, AStrategyGameMode* GameMode);
+	void TryMove(const UBattleManager* BattleManager, const AGridManager* GridManager, ABaseUnit* AIUnit, const FGridCoord& MoveTo);
+	ABaseUnit* GetPlannedUnit(const int32 Index) const;
+	void TryAttack(const UBattleManager* BattleManager, ABaseUnit* AIUnit, const FPlannedAction& Action);
 };
\ No newline at end of file
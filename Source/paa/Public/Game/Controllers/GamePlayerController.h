@@ -10,7 +10,8 @@
 // Delegates
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnPlacementClick, FVector, Location); // Triggered when a tile is clicked during the placement phase.
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitClicked, ABaseUnit*, Unit, bool, bIsLeftClick); // Triggered when a unit is clicked.
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTileClicked, ATile*, Tile, bool, bIsLeftClick); // Triggered when a tile is clicked.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTileClicked, const FGridCoord&, Tile, bool, bIsLeftClick); // Triggered when a tile is clicked.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTileHovered, const FGridCoord&, Tile); // Triggered when the cursor moves onto another tile.
 
 /**
  * AGamePlayerController handles player input and interactions during the game.
@@ -25,6 +26,8 @@ public:
 	AGamePlayerController();
 
 	virtual void BeginPlay() override;
+
+	virtual void PlayerTick(float DeltaTime) override; // Tracks the tile under the cursor.
 	
 	/**
 	 * Initializes the player controller with a reference to the game mode.
@@ -35,13 +38,21 @@ public:
 	virtual void SetupInputComponent() override; // Overrides the default input setup to bind custom input actions.
 
 	FOnPlacementClick OnPlacementClick; // Delegate for placement click events.
-	void PlacementClick(const ATile* Tile) const; // Handles tile clicks during the placement phase.
+	void PlacementClick(const FGridCoord& Tile) const; // Handles tile clicks during the placement phase.
 
 	FOnUnitClicked OnUnitClicked; // Delegate for unit click events.
 	void UnitClicked(ABaseUnit* Unit, const bool bIsLeftClick) const; // Handles unit clicks.
 
 	FOnTileClicked OnTileClicked; // Delegate for tile click events.
-	void TileClicked(ATile* Tile, const bool bIsLeftClick) const; // Handles tile clicks during the battle phase.
+	void TileClicked(const FGridCoord& Tile, const bool bIsLeftClick) const; // Handles tile clicks during the battle phase.
+
+	FOnTileHovered OnTileHovered; // Delegate for hover events; unset when the cursor leaves the grid or input is disabled.
+
+	/**
+	 * Returns the tile under the cursor, as of the last frame.
+	 * @return The coordinate of the tile, or an unset coordinate if the cursor is not over the grid.
+	 */
+	FGridCoord GetHoveredTile() const;
 	
 private:
 	UPROPERTY(VisibleAnywhere)
@@ -56,8 +67,11 @@ private:
 
 	void OnLeftMouseClicked(); // Handles left mouse click events.
 	void OnRightMouseClicked(); // Handles right mouse click events.
+	void ProcessClick(bool bIsLeftClick); // Resolves the tile or unit under the cursor and processes the click.
+
+	FGridCoord PickTileUnderCursor() const; // Intersects the cursor ray with the grid; no physics trace is involved.
 
-	void ProcessTileClick(ATile* Tile, bool bIsLeftClick); // Processes tile clicks based on the current game phase.
+	void ProcessTileClick(const FGridCoord& Tile, bool bIsLeftClick); // Processes tile clicks based on the current game phase.
 	void ProcessUnitClick(ABaseUnit* Unit, bool bIsLeftClick); // Processes unit clicks based on the current game phase.
 
 	UFUNCTION()
@@ -71,4 +85,7 @@ private:
 
 	UPROPERTY(VisibleAnywhere, Category = "Input | Placement")
 	bool bEnableInput; // Whether input is enabled for the player.
+
+	UPROPERTY(VisibleAnywhere, Category = "Input")
+	FGridCoord HoveredTile; // The tile under the cursor, unset if none.
 };
\ No newline at end of file
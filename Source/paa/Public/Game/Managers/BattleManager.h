@@ -3,23 +3,38 @@
 #include "CoreMinimal.h"
 #include "Game/StrategyGameMode.h"
 #include "Units/BrawlerUnit.h"
+#include "Systems/BattleActionRecord.h"
+#include "Systems/BattleRules.h"
+#include "Systems/BattleReplay.h"
+#include "Systems/InfluenceMap.h"
 #include "BattleManager.generated.h"
 
 // Forward Declarations
 class ABaseUnit;
-class ATile;
 class AStrategyGameMode;
 
 // Enum Definitions
-UENUM()
-enum class EActionType : int8 { None, Move, Attack, MoveAndAttack }; // Represents the type of action a unit can perform.
-
 UENUM()
 enum class EClickType { Null, Left, Right }; // Represents the type of click (left or right).
 
+/**
+ * FUnitEntry is one slot of a team's unit registry: a unit handle and its index in the battle state.
+ */
+USTRUCT()
+struct FUnitEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	TWeakObjectPtr<ABaseUnit> Unit; // The unit.
+
+	UPROPERTY(VisibleAnywhere)
+	int32 Index = INDEX_NONE; // The unit's index in the battle state (which also records its action this turn).
+};
+
 // Delegates
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitSelected, ABaseUnit*, Unit, bool, bIsPlayerUnit); // Triggered when a unit is selected.
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnActionExecuted, FString, FormattedAction); // Triggered when an action is executed.
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBattleAction, const FBattleActionRecord&); // Triggered after every move and attack, with its record.
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCanSkipTurn, bool, bCanSkipTurn); // Triggered when the player can skip their turn.
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCanEnd, bool, bEnd, bool, bIsPlayerVictory); // Triggered when the game can end.
 
@@ -39,30 +54,32 @@ public:
     void AddPlayerUnit(ABaseUnit* Unit); // Adds a unit to the player's unit list.
     void AddAIUnit(ABaseUnit* Unit); // Adds a unit to the AI's unit list.
 	
-    UFUNCTION()
-    TArray<FString> GetOccupied() const; // Returns a list of tiles occupied by units.
+	const TBitArray<>& GetOccupiedMask() const; // Returns one bit per grid cell, set where a unit stands (maintained incrementally).
+	bool IsOccupied(const FGridCoord& Tile) const; // Returns whether a unit stands on the tile.
+	ABaseUnit* GetUnitAt(const FGridCoord& Tile) const; // Returns the unit standing on the tile, or nullptr.
 
     UFUNCTION()
     void UnitSelected(ABaseUnit* Unit, bool bIsLeftClick); // Handles unit selection logic.
     UFUNCTION()
-    void TileSelected(ATile* Tile, bool bIsLeftClick); // Handles tile selection logic.
-
+    void TileSelected(const FGridCoord& GridPosition, bool bIsLeftClick); // Handles tile selection logic.
     UFUNCTION()
-    void FormatAction(const int32 Damage, const FString& StartingTile, const FString& EndTile, 
-                      ABaseUnit* Unit, const int32 DamageCounter) const; // Formats and broadcasts action details.
-
-	UFUNCTION()
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> GetAIUnits() const; // Returns the AI's units.
-	UFUNCTION()
-	TMap<TWeakObjectPtr<ABaseUnit>, EActionType> GetPlayerUnits() const; // Returns the player's units.
+    void TileHovered(const FGridCoord& Tile); // Previews the path of the selected unit's move to the hovered tile.
+
+	TConstArrayView<FUnitEntry> GetAIUnits() const; // Returns a read-only view of the AI's units, valid until units are added or removed.
+	TConstArrayView<FUnitEntry> GetPlayerUnits() const; // Returns a read-only view of the player's units, valid until units are added or removed.
+	TConstArrayView<FUnitEntry> GetUnits(const bool bPlayerTeam) const; // Returns a read-only view of one team's units.
+	bool IsPlayerUnit(const ABaseUnit* Unit) const; // Returns whether the unit belongs to the player's team.
+	const FBattleState& GetBattleState() const; // Returns the plain-data state the battle is played on.
+	const FBattleReplay& GetReplay() const; // Returns the binary log of the current match, recorded since the placement phase started.
+	const FInfluenceMap& GetInfluenceMap() const; // Returns the AI team's influence map, kept up to date with every action of the battle.
+	ABaseUnit* GetUnitByIndex(const int32 Index) const; // Returns the living unit with the given battle state index, or nullptr.
 	UFUNCTION()
-	TArray<FString> GetColored() const; // Returns the currently highlighted tiles.
+	TArray<FGridCoord> GetColored() const; // Returns the currently highlighted tiles.
 
     UPROPERTY()
     FOnUnitSelected OnUnitSelected; // Delegate for unit selection events.
     
-    UPROPERTY()
-    FOnActionExecuted OnActionExecuted; // Delegate for action execution events.
+    FOnBattleAction OnBattleAction; // Native event for every executed action; listeners format the record only if they show it.
 
 	UPROPERTY()
 	FOnCanSkipTurn OnCanSkipTurn; // Delegate for turn skip events.
@@ -72,7 +89,7 @@ public:
 
 private:
     void AttackUnit(ABaseUnit* Unit); // Handles attacking a unit.
-    void MoveUnit(const FString& GridPosition); // Handles moving a unit.
+    void MoveUnit(const FGridCoord& GridPosition); // Handles moving a unit.
 	void CheckCanSkipTurn() const; // Checks if the player can skip their turn.
 	void CheckEndConditions() const; // Checks if the game has ended.
 
@@ -82,6 +99,16 @@ private:
 	void ClearSelection(TWeakObjectPtr<AGridManager> GridManager); // Clears the current selection.
 	bool IsAttackScenario(const ABaseUnit* Unit, const EClickType Click) const; // Determines if an attack should occur.
 	void HandleUnitDeath(ABaseUnit* Attacker, ABaseUnit* Target); // Handles unit death logic.
+
+	FUnitEntry* FindEntry(const ABaseUnit* Unit); // Returns the registry slot of a unit in either team, or nullptr.
+	const FUnitEntry* FindEntry(const ABaseUnit* Unit) const; // Returns the registry slot of a unit in either team, or nullptr.
+
+	void ResetOccupancy(); // Resets the battle state to the current grid and empties the occupancy index.
+	void SetOccupant(const FGridCoord& Tile, ABaseUnit* Unit); // Records the unit actor standing on a tile (nullptr frees it).
+	int32 AddToState(ABaseUnit* Unit, const bool bPlayerTeam); // Adds a unit to the battle state and indexes its tile.
+	void RebuildInfluence(); // Computes the AI team's influence map from scratch, at battle and turn start.
+	void UpdateInfluence(const int32 Unit); // Updates the influence map after a unit moved or died.
+	void ShowInfluence() const; // Tints the tiles with the influence layer chosen by paa.AI.ShowInfluence, if any.
 	
     UFUNCTION()
     void OnGamePhaseChanged(EGamePhase NewPhase); // Handles game phase changes.
@@ -93,10 +120,18 @@ private:
     bool bIsPlayerTurn; // True if it's the player's turn, false for AI.
 
     UPROPERTY(VisibleAnywhere)
-    TMap<TWeakObjectPtr<ABaseUnit>, EActionType> PlayerUnits; // Tracks player units and their actions.
+    TArray<FUnitEntry> PlayerUnits; // Tracks player units and their actions, in placement order.
     
     UPROPERTY(VisibleAnywhere)
-    TMap<TWeakObjectPtr<ABaseUnit>, EActionType> AIUnits; // Tracks AI units and their actions.
+    TArray<FUnitEntry> AIUnits; // Tracks AI units and their actions, in placement order.
+
+	FBattleState State; // Positions, life points, actions and occupancy of every unit; the actors mirror it.
+	FBattleReplay Replay; // Every placement, move, attack and turn of the current match.
+	FInfluenceMap Influence; // Threat, support and distance layers from the AI team's point of view.
+	mutable bool bInfluenceShown = false; // Whether the tiles currently show an influence layer.
+	TArray<TWeakObjectPtr<ABaseUnit>> Occupants; // The unit standing on each grid cell, by flat index.
+	FGridPathTree MoveTree; // The selected unit's shortest-path tree, reused for every hovered tile until the occupancy or the obstacles change.
+	TArray<FGridCoord> PreviewPath; // The previewed path, reused between hovered tiles.
 
     UPROPERTY(VisibleAnywhere)
     TWeakObjectPtr<ABaseUnit> SelectedUnit; // Currently selected unit.
@@ -105,5 +140,5 @@ private:
     EClickType ClickType = EClickType::Null; // Type of the last click (left or right).
     
     UPROPERTY(VisibleAnywhere)
-    TArray<FString> ColoredTiles; // Tiles currently highlighted for movement/attack.
+    TArray<FGridCoord> ColoredTiles; // Tiles currently highlighted for movement/attack.
 };
\ No newline at end of file
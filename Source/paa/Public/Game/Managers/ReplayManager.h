@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Game/StrategyGameMode.h"
+#include "Systems/BattleReplay.h"
+#include "ReplayManager.generated.h"
+
+// Forward Declarations
+class ABaseUnit;
+
+/**
+ * ReplayManager class saves the match recordings of the battle manager and plays recorded matches back in real time
+ * with the actors, by feeding the recorded placements and clicks to the game like the AI does.
+ * Headless, as-fast-as-possible playback does not need it: see FBattleReplay::Simulate and paa.Replay.Simulate.
+ */
+UCLASS()
+class PAA_API UReplayManager : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Initializes the ReplayManager with a reference to the game mode.
+	 * @param GameModeRef - The game mode instance.
+	 */
+	void Initialize(AStrategyGameMode* GameModeRef);
+
+	/**
+	 * Starts playing a recorded match back in real time. Only possible from the begin screen;
+	 * the coin flip is skipped and the recorded obstacles replace the generated ones.
+	 * @param InReplay - The recorded match.
+	 * @return True if playback started.
+	 */
+	bool StartPlayback(FBattleReplay&& InReplay);
+
+	/**
+	 * Stops the playback; the match stays where it is.
+	 */
+	void StopPlayback();
+
+	/**
+	 * Returns whether a recorded match is being played back.
+	 * @return True during playback.
+	 */
+	bool IsPlaying() const;
+
+	/**
+	 * Writes the recording of the current match to a file.
+	 * @param Filename - The file name, relative to the replay folder unless absolute; empty uses the current date and time.
+	 * @return True if the file was written.
+	 */
+	bool SaveRecording(const FString& Filename) const;
+
+	/**
+	 * Resolves the path of a replay file.
+	 * @param Filename - The file name, relative to the replay folder unless absolute.
+	 * @return The full path, with the replay extension.
+	 */
+	static FString GetReplayPath(const FString& Filename);
+
+private:
+	/**
+	 * Handles game phase changes: saves the finished match, or ends the playback.
+	 * @param NewPhase - The new game phase.
+	 */
+	UFUNCTION()
+	void OnGamePhaseChanged(EGamePhase NewPhase);
+
+	/**
+	 * Waits until the next record is due, as long as it took when the match was recorded.
+	 */
+	void ScheduleNextRecord();
+
+	/**
+	 * Plays the next record and schedules the following one.
+	 */
+	void PlayNextRecord();
+
+	/**
+	 * Stops the playback after a record could not be reproduced.
+	 * @param Record - The index of the record.
+	 * @param Reason - What went wrong.
+	 */
+	void Diverge(const int32 Record, const TCHAR* Reason);
+
+	/**
+	 * Compares the played-back battle with the headless re-execution of the recording and logs the outcome.
+	 */
+	void CheckFinalState() const;
+
+	TWeakObjectPtr<AStrategyGameMode> GameMode; // Reference to the game mode.
+
+	FBattleReplay Replay; // The match being played back.
+
+	int32 NextRecord = 0; // The index of the next record to play.
+
+	bool bPlaying = false; // Whether a match is being played back.
+
+	bool bBattleStarted = false; // Whether the first battle turn was reached (it starts by itself after the last placement).
+
+	FTimerHandle RecordTimer; // Fires when the next record is due.
+};
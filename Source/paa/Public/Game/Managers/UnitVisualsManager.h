@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Units/UnitVisualsAsset.h"
+#include "UnitVisualsManager.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnUnitVisualsReady); // Triggered once every unit texture is loaded.
+
+/**
+ * UnitVisualsManager streams the unit textures in the background and shares them with the UI and the units,
+ * so no widget loads them from disk on the game thread. Loading starts with the Begin phase; until it completes,
+ * GetTexture returns null and readers wait for OnVisualsReady.
+ */
+UCLASS()
+class PAA_API UUnitVisualsManager : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Initializes the UnitVisualsManager with the asset listing the textures.
+	 * @param InVisuals - The unit visuals asset; if null, the textures of the default content are used.
+	 */
+	void Initialize(const TSoftObjectPtr<UUnitVisualsAsset>& InVisuals);
+
+	/**
+	 * Starts streaming the textures in, if they are not loaded or loading already.
+	 */
+	void Preload();
+
+	/**
+	 * Returns whether every texture finished loading.
+	 * @return True once OnVisualsReady was broadcast.
+	 */
+	bool IsReady() const;
+
+	/**
+	 * Returns the texture of a unit.
+	 * @param Type - The unit type.
+	 * @param Color - The team color index.
+	 * @return The texture, or null if it is not loaded (yet).
+	 */
+	UTexture2D* GetTexture(const EUnitTypes Type, const int32 Color) const;
+
+	UPROPERTY()
+	FOnUnitVisualsReady OnVisualsReady; // Delegate for the end of the loading.
+
+private:
+	/**
+	 * Collects the texture paths of the loaded asset and streams them in.
+	 */
+	void OnVisualsAssetLoaded();
+
+	/**
+	 * Streams the textures of SniperPaths and BrawlerPaths in.
+	 */
+	void RequestTextures();
+
+	/**
+	 * Keeps the loaded textures and signals that they are ready.
+	 */
+	void OnTexturesLoaded();
+
+	TSoftObjectPtr<UUnitVisualsAsset> Visuals; // The asset listing the textures.
+
+	TArray<FSoftObjectPath> SniperPaths; // The sniper's texture for every team color.
+
+	TArray<FSoftObjectPath> BrawlerPaths; // The brawler's texture for every team color.
+
+	UPROPERTY()
+	TArray<UTexture2D*> SniperTextures; // The loaded sniper textures, null where loading failed.
+
+	UPROPERTY()
+	TArray<UTexture2D*> BrawlerTextures; // The loaded brawler textures, null where loading failed.
+
+	FStreamableManager Streamable; // Issues the asynchronous loads.
+
+	TSharedPtr<FStreamableHandle> Handle; // The load in flight, or the finished load keeping the assets resident.
+
+	bool bReady = false; // Whether the textures finished loading.
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FMatchRng is a small, fast PCG32 random number generator (64-bit state, 32-bit output).
+ * Two generators with the same seed and sequence produce the same numbers on every platform;
+ * generators with the same seed but different sequences are independent streams.
+ */
+struct PAA_API FMatchRng
+{
+	FMatchRng() = default;
+	FMatchRng(const uint64 Seed, const uint64 Sequence = 0) { Initialize(Seed, Sequence); }
+
+	/**
+	 * Restarts the generator.
+	 * @param Seed - The starting point of the stream.
+	 * @param Sequence - Selects one of 2^63 independent streams for the same seed.
+	 */
+	void Initialize(const uint64 Seed, const uint64 Sequence = 0)
+	{
+		State = 0;
+		Increment = (Sequence << 1u) | 1u;
+		Next();
+		State += Seed;
+		Next();
+	}
+
+	/** @return The next 32 random bits. */
+	uint32 Next()
+	{
+		const uint64 Old = State;
+		State = Old * 6364136223846793005ull + Increment;
+
+		const uint32 XorShifted = uint32(((Old >> 18u) ^ Old) >> 27u);
+		const uint32 Rotation = uint32(Old >> 59u);
+		return (XorShifted >> Rotation) | (XorShifted << ((0u - Rotation) & 31u));
+	}
+
+	/**
+	 * Draws an unbiased integer in [0, Range) (Lemire's multiply-and-reject).
+	 * @param Range - The number of possible values; must be positive.
+	 * @return The drawn integer.
+	 */
+	int32 RandHelper(const int32 Range)
+	{
+		check(Range > 0);
+
+		const uint32 Bound = uint32(Range);
+		uint64 Product = uint64(Next()) * Bound;
+
+		if (uint32(Product) < Bound)
+		{
+			const uint32 Threshold = (0u - Bound) % Bound;
+			while (uint32(Product) < Threshold)
+			{
+				Product = uint64(Next()) * Bound;
+			}
+		}
+
+		return int32(Product >> 32u);
+	}
+
+	/** @return An integer in [Min, Max], both inclusive. */
+	int32 RandRange(const int32 Min, const int32 Max) { return Min + RandHelper(Max - Min + 1); }
+
+	/** @return A float in [0, 1). */
+	float FRand() { return (Next() >> 8u) * (1.f / 16777216.f); }
+
+	/** @return True or false with equal probability. */
+	bool RandBool() { return (Next() >> 31u) != 0; }
+
+	bool operator==(const FMatchRng& Other) const { return State == Other.State && Increment == Other.Increment; }
+	bool operator!=(const FMatchRng& Other) const { return !(*this == Other); }
+
+private:
+	uint64 State = 0x853c49e6748fea9bull; // The generator state.
+	uint64 Increment = 0xda3e39cb94b95bdbull; // The stream selector; always odd.
+};
+
+/**
+ * ERandomStream names the subsystems that draw random numbers during a match.
+ * Each one owns its own stream, so extra draws in one subsystem never shift the numbers of another.
+ */
+enum class ERandomStream : uint8
+{
+	TileVariants, // Texture variant of every tile.
+	Obstacles, // Obstacle layout (unless AGridManager pins its own seed).
+	CoinFlip, // Which side plays first.
+	AIPlacement, // Where the AI places its units.
+	Damage, // Attack and counter-attack damage.
+	AISearch, // Seeds of the AI's turn search.
+	Count
+};
+
+/**
+ * FMatchRandom derives every random stream of a match from a single seed, so a match can be reproduced
+ * from its seed and the player's inputs.
+ */
+struct PAA_API FMatchRandom
+{
+	/**
+	 * Restarts every stream from a match seed.
+	 * @param InSeed - The match seed.
+	 */
+	void Initialize(const int32 InSeed)
+	{
+		Seed = InSeed;
+
+		for (int32 Stream = 0; Stream < int32(ERandomStream::Count); ++Stream)
+		{
+			Streams[Stream].Initialize(uint32(Seed), Stream);
+		}
+	}
+
+	/** @return The seed of the current match. */
+	int32 GetSeed() const { return Seed; }
+
+	/** @return The stream of a subsystem. */
+	FMatchRng& Get(const ERandomStream Stream) { return Streams[int32(Stream)]; }
+
+private:
+	int32 Seed = 0; // The seed of the current match.
+	FMatchRng Streams[int32(ERandomStream::Count)]; // One stream per subsystem.
+};
@@ -2,12 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "PlayerPawn.h"
+#include "MatchRandom.h"
 #include "GameFramework/GameModeBase.h"
 #include "StrategyGameMode.generated.h"
 
 class UUIManager;
 class UBattleManager;
 class UPlacementManager;
+class UReplayManager;
+class UUnitVisualsAsset;
+class UUnitVisualsManager;
 class AGamePlayerController;
 class AGridManager;
 class UGameAIController;
@@ -69,6 +73,14 @@ public:
 	UWorld* World() const;
 	UFUNCTION()
 	bool IsPlayerTurn() const;
+	UFUNCTION()
+	EGamePhase GetCurrentPhase() const;
+	
+	/**
+	 * Returns whether a recorded match is being played back, in which case neither the player nor the AI act.
+	 * @return True during playback.
+	 */
+	bool IsReplaying() const;
 	
 	UFUNCTION()
 	TWeakObjectPtr<AGamePlayerController> GetPlayerController() const;
@@ -79,6 +91,29 @@ public:
 	UBattleManager* GetBattleManager();
 	UFUNCTION()
 	AGridManager* GetGridManager();
+	UFUNCTION()
+	UReplayManager* GetReplayManager();
+	UFUNCTION()
+	UUnitVisualsManager* GetUnitVisualsManager();
+
+	/**
+	 * Returns the random stream of a subsystem for the current match.
+	 * @param Stream - The subsystem.
+	 * @return The stream.
+	 */
+	FMatchRng& GetRandomStream(const ERandomStream Stream);
+
+	/**
+	 * Returns the seed every random stream of the current match derives from.
+	 * @return The match seed.
+	 */
+	int32 GetMatchSeed() const;
+
+	/**
+	 * Restarts every random stream of the current match from another seed (e.g. the seed of a replay).
+	 * @param Seed - The new match seed.
+	 */
+	void ReseedMatch(const int32 Seed);
 
 protected:
 	virtual void BeginPlay() override;
@@ -100,10 +135,22 @@ private:
 	UBattleManager* BattleManager;
 	UPROPERTY(VisibleAnywhere)
 	UUIManager* UIManager;
+	UPROPERTY(VisibleAnywhere)
+	UReplayManager* ReplayManager;
+	UPROPERTY(VisibleAnywhere)
+	UUnitVisualsManager* UnitVisualsManager;
 	
 	UPROPERTY(VisibleAnywhere, Category = "GameMode | Phase")
 	EGamePhase CurrentPhase;
 
 	UPROPERTY(VisibleAnywhere, Category = "GameMode | Turn")
 	bool bIsPlayerTurn;
+
+	UPROPERTY(EditAnywhere, Category = "GameMode | Random")
+	int32 MatchSeed = 0; // The seed of every match; 0 draws a new seed for every match.
+
+	UPROPERTY(EditAnywhere, Category = "GameMode | Units")
+	TSoftObjectPtr<UUnitVisualsAsset> UnitVisuals; // The textures of the units; the default content's textures if unset.
+
+	FMatchRandom Random; // The random streams of the current match.
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTypes.h"
+#include "Grid/Utils/PathfindingUtilities.h"
+#include "DistanceFieldCache.generated.h"
+
+// Forward Declarations
+class AGridManager;
+
+/**
+ * UDistanceFieldCache keeps one distance field (a "Dijkstra map" of movement points) per source tile for the battle phase.
+ * Fields are built once, usually at turn start for every unit position, and then answer movement range and
+ * "how far is this tile from that unit" questions with a single array lookup.
+ * A field stays valid until the walls change (Reset) or a tile it touches changes occupancy (InvalidateTile).
+ */
+UCLASS()
+class PAA_API UDistanceFieldCache : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Initializes the cache with the grid it reads from.
+	 * @param InGridManager - The grid manager owning this cache.
+	 */
+	void Initialize(const AGridManager* InGridManager);
+
+	/**
+	 * Builds the field of every occupied tile that is not cached yet, i.e. of every unit position.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied.
+	 */
+	void Warm(const TBitArray<>& Occupied);
+
+	/**
+	 * Returns the walking distance between two tiles, building the field of the source if needed.
+	 * @param Source - The tile the field is built from.
+	 * @param Target - The tile to look up.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied.
+	 * @return The movement points needed, or INDEX_NONE if the target cannot be reached (obstacles and occupied tiles never can).
+	 */
+	int32 GetDistance(const FGridCoord& Source, const FGridCoord& Target, const TBitArray<>& Occupied);
+
+	/**
+	 * Collects every tile reachable from a source with a given number of movement points, source included.
+	 * Only the Manhattan diamond around the source is scanned (every step costs at least 1); the field answers each tile in O(1).
+	 * @param Source - The tile the field is built from.
+	 * @param Range - The movement points.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied.
+	 * @return A view of the reachable tiles, valid until the next range query on this cache.
+	 */
+	TConstArrayView<FGridCoord> GetReachable(const FGridCoord& Source, const int32 Range, const TBitArray<>& Occupied);
+
+	/**
+	 * Drops every field that may change because a tile became occupied or free.
+	 * A field is affected only if it reached the tile itself or one of its neighbours.
+	 * @param Tile - The tile whose occupancy changed.
+	 */
+	void InvalidateTile(const FGridCoord& Tile);
+
+	/**
+	 * Drops every field, e.g. after the obstacles or the grid size changed.
+	 */
+	void Reset();
+
+private:
+	/**
+	 * Returns the field of a source tile, building it if it is not cached.
+	 * @param Source - The flat index of the source tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied.
+	 * @return The per-cell distances of the field.
+	 */
+	const TArray<int32>& FindOrBuild(const int32 Source, const TBitArray<>& Occupied);
+
+	TWeakObjectPtr<const AGridManager> GridManager; // The grid the fields are built on.
+
+	TMap<int32, TArray<int32>> Fields; // The distance field of each cached source, keyed by flat index.
+
+	TArray<TArray<int32>> FreeFields; // Storage of dropped fields, reused by the next builds.
+
+	FGridBucketQueue Queue; // Reusable search queue.
+
+	TArray<FGridCoord> Reachable; // The result of the last range query.
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/GridTypes.h"
+
+/**
+ * FGridBitboard is a set of grid cells stored one bit per cell, each row packed into consecutive 64-bit words
+ * (column X is bit X % 64 of word X / 64 of its row). Bits past the grid width are always clear.
+ * Range queries on the 4-connected grid become word-wide set operations: a step of dilation is five shifts
+ * and ORs per word, so a unit's whole movement range costs a few dozen word operations instead of a BFS.
+ * The word loops are plain contiguous loops the compiler vectorizes (SSE/AVX2/NEON) on wide grids.
+ */
+struct PAA_API FGridBitboard
+{
+	/**
+	 * Resizes the board and clears every cell.
+	 * @param InSizeX - The width of the grid.
+	 * @param InSizeY - The height of the grid.
+	 */
+	void Init(const int32 InSizeX, const int32 InSizeY);
+
+	/** Clears every cell, keeping the size. */
+	void Reset();
+
+	/** @return The width of the grid. */
+	int32 GetSizeX() const { return SizeX; }
+
+	/** @return The height of the grid. */
+	int32 GetSizeY() const { return SizeY; }
+
+	/** @return True if the cell is in the set; cells outside the grid never are. */
+	bool Get(const FGridCoord& Coord) const
+	{
+		return Coord.X >= 0 && Coord.X < SizeX && Coord.Y >= 0 && Coord.Y < SizeY &&
+			(Words[Coord.Y * WordsPerRow + (Coord.X >> 6)] >> (Coord.X & 63) & 1) != 0;
+	}
+
+	/** Adds a cell to the set or removes it; cells outside the grid are ignored. */
+	void Set(const FGridCoord& Coord, const bool bValue)
+	{
+		if (Coord.X < 0 || Coord.X >= SizeX || Coord.Y < 0 || Coord.Y >= SizeY) return;
+
+		uint64& Word = Words[Coord.Y * WordsPerRow + (Coord.X >> 6)];
+		const uint64 Bit = uint64(1) << (Coord.X & 63);
+		Word = bValue ? Word | Bit : Word & ~Bit;
+	}
+
+	/**
+	 * Adds a run of up to 64 cells of a row, given as a bit mask; cells falling outside the grid are dropped.
+	 * @param Row - The row of the cells.
+	 * @param FirstX - The column of bit 0 of the mask; may be negative.
+	 * @param Bits - The cells to add, bit I standing for column FirstX + I.
+	 */
+	void OrRowBits(const int32 Row, int32 FirstX, uint64 Bits);
+
+	/**
+	 * Makes the board the set of cells a unit may walk through: inside the grid, not an obstacle and not occupied.
+	 * @param Grid - The grid data.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 */
+	void SetWalkable(const FGridData& Grid, const TBitArray<>& Occupied);
+
+	/**
+	 * Makes the board the Manhattan diamond of a given radius around a cell, clipped to the grid.
+	 * @param Center - The center of the diamond.
+	 * @param Range - The radius; the center alone for 0.
+	 */
+	void SetDiamond(const FGridCoord& Center, const int32 Range);
+
+	/**
+	 * Grows the set by up to Steps orthogonal steps, only ever adding cells of Walkable. Cells already in the set
+	 * stay in it even if they are not walkable (e.g. the occupied tile of the unit the range belongs to).
+	 * The result is every cell a BFS through Walkable reaches within Steps steps. Stops early once the set stops growing.
+	 * @param Walkable - The cells the set may grow into; must have the same size.
+	 * @param Steps - The maximum number of steps.
+	 */
+	void Dilate(const FGridBitboard& Walkable, const int32 Steps);
+
+	/** Keeps only the cells also in Other (same size). */
+	void And(const FGridBitboard& Other);
+
+	/** Adds the cells of Other (same size). */
+	void Or(const FGridBitboard& Other);
+
+	/** Removes the cells of Other (same size). */
+	void AndNot(const FGridBitboard& Other);
+
+	/** @return True if the two sets (same size) share a cell. */
+	bool Intersects(const FGridBitboard& Other) const;
+
+	/** @return The number of cells in the set. */
+	int32 CountSetBits() const;
+
+	/**
+	 * Calls a function for every cell in the set, in row-major order (rows ascending, then columns ascending).
+	 * @param Visit - Called with the coordinate of each cell.
+	 */
+	template <typename FunctorType>
+	void ForEachSetBit(FunctorType&& Visit) const
+	{
+		for (int32 Row = 0; Row < SizeY; ++Row)
+		{
+			for (int32 Word = 0; Word < WordsPerRow; ++Word)
+			{
+				for (uint64 Bits = Words[Row * WordsPerRow + Word]; Bits != 0; Bits &= Bits - 1)
+				{
+					Visit(FGridCoord(Word * 64 + int32(FMath::CountTrailingZeros64(Bits)), Row));
+				}
+			}
+		}
+	}
+
+private:
+	/**
+	 * Finds the rows the set lies in, so empty rows can be skipped.
+	 * @param OutFirstRow - Receives the first row with a cell, or SizeY if the set is empty.
+	 * @param OutLastRow - Receives the last row with a cell, or -1 if the set is empty.
+	 */
+	void GetRowBounds(int32& OutFirstRow, int32& OutLastRow) const;
+
+	int32 SizeX = 0; // The width of the grid.
+	int32 SizeY = 0; // The height of the grid.
+	int32 WordsPerRow = 0; // The number of 64-bit words holding a row.
+	TArray<uint64> Words; // The rows, one after the other.
+	TArray<uint64> RowScratch; // The previous contents of the two rows around the one being dilated.
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/GridTypes.h"
+#include "Grid/Utils/PathfindingUtilities.h"
+
+/**
+ * FGridHierarchy is the abstract layer of hierarchical pathfinding (HPA*) for large maps.
+ * The grid is split into square sectors; every maximal open stretch of a border between two sectors is an entrance,
+ * with a transition cell on each side of it (one in the middle, or one at each end for long stretches).
+ * Transition cells are the nodes of the abstract graph: the nodes of a sector are linked by their walking distance
+ * inside the sector, and nodes facing each other across a border by a single step.
+ * A query searches the small abstract graph and then refines each hop into tiles inside a single sector.
+ * Paths are near-optimal (they cross borders at transition cells only); short queries, and every query on a grid
+ * with movement costs, use the flat A* instead.
+ * Occupied tiles are walls of the graph too: each query compares the occupancy mask with the one the graph was
+ * built against and repairs only the sectors around tiles that changed.
+ */
+struct PAA_API FGridHierarchy
+{
+	/**
+	 * Builds the graph of every sector from the grid's obstacles, with no tile occupied.
+	 * @param Grid - The grid data.
+	 * @param InClusterSize - The width and height of a sector, in tiles.
+	 */
+	void Build(const FGridData& Grid, const int32 InClusterSize);
+
+	/** Drops the graph, e.g. after the grid size changed. */
+	void Reset();
+
+	/** @return True if the graph was built and can answer queries. */
+	bool IsBuilt() const { return ClusterSize > 0; }
+
+	/**
+	 * Brings the graph up to date with an occupancy mask, rebuilding only the sectors whose tiles changed
+	 * (and the neighbours across a border the changed tiles lie on).
+	 * @param Grid - The grid data the graph was built from.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @return The number of sectors rebuilt.
+	 */
+	int32 Sync(const FGridData& Grid, const TBitArray<>& Occupied);
+
+	/**
+	 * Finds a path from a start tile to an end tile. Queries within a sector's reach, and queries the abstract graph
+	 * cannot answer (e.g. the only way out of the start sector is the start tile itself), fall back to the flat A*.
+	 * @param Grid - The grid data the graph was built from.
+	 * @param StartTile - The coordinate of the starting tile.
+	 * @param EndTile - The coordinate of the destination tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param Scratch - Reusable search bookkeeping owned by the grid, shared with the flat A*.
+	 * @return An array of tile coordinates representing the path from start to end, empty if there is none.
+	 */
+	TArray<FGridCoord> FindPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied, FGridSearchScratch& Scratch);
+
+	/**
+	 * Finds a path through the abstract graph only, leaving the queries FindPath would hand to the flat A* to the caller,
+	 * so the caller can answer them with its own flat search.
+	 * @param Grid - The grid data the graph was built from.
+	 * @param StartTile - The coordinate of the starting tile.
+	 * @param EndTile - The coordinate of the destination tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param Scratch - Reusable search bookkeeping owned by the grid.
+	 * @param OutPath - Receives the path from start to end when the graph answers the query.
+	 * @return False if the query needs a flat search.
+	 */
+	bool TryFindPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied, FGridSearchScratch& Scratch, TArray<FGridCoord>& OutPath);
+
+	/**
+	 * Searches the abstract graph between two cells in different sectors; the graph must be in sync.
+	 * @param Grid - The grid data the graph was built from.
+	 * @param Start - The flat index of the starting cell; it may be occupied.
+	 * @param End - The flat index of the destination cell.
+	 * @param Scratch - Reusable search bookkeeping.
+	 * @param OutNodes - Receives the cells of the abstract path, start and end included.
+	 * @return True if an abstract path was found.
+	 */
+	bool FindAbstractPath(const FGridData& Grid, const int32 Start, const int32 End, FGridSearchScratch& Scratch, TArray<int32>& OutNodes);
+
+	/**
+	 * Turns an abstract path into tiles: hops across a border are single steps, hops inside a sector are
+	 * shortest walks within it.
+	 * @param Grid - The grid data the graph was built from.
+	 * @param Nodes - The cells of the abstract path.
+	 * @param OutPath - Receives the tiles of the path, start and end included.
+	 */
+	void RefinePath(const FGridData& Grid, TConstArrayView<int32> Nodes, TArray<FGridCoord>& OutPath);
+
+	/** @return The width and height of a sector, or 0 if the graph is not built. */
+	int32 GetClusterSize() const { return ClusterSize; }
+
+	/** @return The number of nodes of the abstract graph. */
+	int32 GetNumNodes() const;
+
+private:
+	/** The nodes of one sector and the walking distances between them. */
+	struct FSector
+	{
+		int32 MinX = 0; // The first column of the sector.
+		int32 MinY = 0; // The first row of the sector.
+		int32 MaxX = 0; // The last column of the sector.
+		int32 MaxY = 0; // The last row of the sector.
+		TArray<int32> Nodes; // The transition cells of the sector.
+		TArray<int32> Distances; // Nodes.Num() squared distances inside the sector, row per node; INDEX_NONE if unreachable.
+	};
+
+	/** @return The index of the sector holding a cell. */
+	int32 GetSectorOf(const FGridData& Grid, const int32 Cell) const;
+
+	/**
+	 * Recomputes the nodes of a sector from its four borders, and the distances between them.
+	 * @param Grid - The grid data.
+	 * @param Sector - The index of the sector.
+	 */
+	void RebuildSector(const FGridData& Grid, const int32 Sector);
+
+	/**
+	 * Adds the transition cells a border contributes to a sector.
+	 * @param Grid - The grid data.
+	 * @param Sector - The sector being rebuilt.
+	 * @param First - The first cell of the sector's side of the border.
+	 * @param Stride - The step between consecutive cells along the border.
+	 * @param Length - The number of cells along the border.
+	 * @param Across - The offset from a cell of the border to the cell facing it in the other sector.
+	 */
+	void AddBorderNodes(const FGridData& Grid, FSector& Sector, const int32 First, const int32 Stride, const int32 Length, const int32 Across);
+
+	/**
+	 * Runs a BFS from a cell that never leaves the cell's sector, filling LocalDistance and LocalParent.
+	 * @param Grid - The grid data.
+	 * @param Sector - The sector to search.
+	 * @param Source - The flat index of the source; it may be occupied.
+	 */
+	void SearchSector(const FGridData& Grid, const FSector& Sector, const int32 Source);
+
+	/** @return The index of a cell in the local arrays of a sector search. */
+	static int32 ToLocal(const FGridData& Grid, const FSector& Sector, const int32 Cell)
+	{
+		return (Cell / Grid.SizeX - Sector.MinY) * (Sector.MaxX - Sector.MinX + 1) + Cell % Grid.SizeX - Sector.MinX;
+	}
+
+	/** @return The flat index of an entry of the local arrays of a sector search. */
+	static int32 ToCell(const FGridData& Grid, const FSector& Sector, const int32 Local)
+	{
+		const int32 Width = Sector.MaxX - Sector.MinX + 1;
+		return (Sector.MinY + Local / Width) * Grid.SizeX + Sector.MinX + Local % Width;
+	}
+
+	int32 ClusterSize = 0; // The width and height of a sector.
+
+	int32 SectorsX = 0; // The number of sector columns.
+
+	TArray<FSector> Sectors; // Every sector, row-major.
+
+	TArray<int32> NodeSlot; // The index of each cell in its sector's node list, or INDEX_NONE if it is not a node.
+
+	TBitArray<> Blocked; // The cells the graph treats as walls: obstacles and the occupied tiles it was synced with.
+
+	TBitArray<> Occupancy; // The occupancy mask the graph was synced with.
+
+	TBitArray<> DirtySectors; // One bit per sector, set while it waits to be rebuilt.
+
+	TArray<int32> DirtyList; // The sectors waiting to be rebuilt.
+
+	TArray<int32> LocalDistance; // Reusable distances of a sector search.
+
+	TArray<int32> LocalParent; // Reusable parents of a sector search.
+
+	TArray<int32> LocalQueue; // Reusable FIFO of a sector search.
+
+	TArray<int32> EndCost; // The walking distance from each node of the end sector to the end of the current query.
+
+	TArray<TPair<int32, int32>> StartLinks; // The nodes of the start sector reachable from the start, with their distances.
+};
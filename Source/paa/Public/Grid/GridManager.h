@@ -1,15 +1,36 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GridTypes.h"
+#include "DistanceFieldCache.h"
+#include "GridHierarchy.h"
+#include "Grid/Utils/PathfindingUtilities.h"
 #include "Tile.h"
 #include "Game/StrategyGameMode.h"
 #include "GameFramework/Actor.h"
 #include "GridManager.generated.h"
 
+// Forward Declarations
+class UInstancedStaticMeshComponent;
+
+UENUM()
+enum class EGridRenderMode : uint8
+{
+	Actors, // One ATile actor per cell.
+	Instanced // A single instanced mesh; each cell is an instance with custom data (BaseColor, TextureIndex, bIsObstacle).
+};
+
+UENUM()
+enum class EGridPathSearch : uint8
+{
+	AStar, // A* over every cell.
+	JumpPoint // Jump Point Search: same path lengths, far fewer open list entries on open maps.
+};
+
 /**
  * AGridManager is responsible for creating and managing a grid of tiles.
  * It provides functions to generate the grid, place obstacles, reset the grid state,
- * and convert between grid coordinates (tile names) and world coordinates.
+ * and convert between grid coordinates and world coordinates.
  */
 UCLASS()
 class PAA_API AGridManager : public AActor
@@ -21,13 +42,14 @@ public:
 
 	/**
 	 * Initializes the grid manager with a reference to the game mode.
-	 * @param GameMode - The game mode instance.
+	 * @param InGameMode - The game mode instance.
 	 */
 	UFUNCTION()
-	void Initialize(AStrategyGameMode* GameMode);
+	void Initialize(AStrategyGameMode* InGameMode);
 	
 	/**
-	 * Generates the grid by spawning tiles and storing them in a map.
+	 * Generates the grid in the configured render mode: either one tile actor per cell
+	 * or one mesh instance per cell (in which case no tile actors exist).
 	 */
 	UFUNCTION()
 	void GenerateGrid();
@@ -39,65 +61,175 @@ public:
 	void GenerateObstacles();
 
 	/**
-	 * Converts a grid coordinate (e.g., "A1") to a world position.
-	 * @param TileName - The name of the tile in grid format (e.g., "A1").
+	 * Replaces the obstacles with a given layout (e.g. the one recorded in a replay).
+	 * @param Obstacles - One bit per cell, set for obstacles; must match the grid size.
+	 */
+	void SetObstacles(const TBitArray<>& Obstacles);
+
+	/**
+	 * Replaces the movement cost of every tile.
+	 * @param Costs - One cost per cell, at least 1; empty makes every tile cost 1.
+	 */
+	void SetMovementCosts(const TArray<uint8>& Costs);
+
+	/**
+	 * Converts a grid coordinate to a world position.
+	 * @param Coord - The coordinate of the tile.
 	 * @return The world position of the tile.
 	 */
 	UFUNCTION()
-	FVector GridToWorld(const FString& TileName) const;
+	FVector GridToWorld(const FGridCoord& Coord) const;
 
 	/**
-	 * Converts a world position to a grid coordinate (e.g., "A1").
+	 * Converts a world position to a grid coordinate.
 	 * @param TilePosition - The world position of the tile.
-	 * @return The grid coordinate as a string (e.g., "A1").
+	 * @return The grid coordinate, or an unset coordinate if the position lies outside the grid.
 	 */
 	UFUNCTION()
-	FString WorldToGrid(const FVector& TilePosition) const;
+	FGridCoord WorldToGrid(const FVector& TilePosition) const;
 
 	/**
-	 * Retrieves a tile from the grid using its name.
-	 * @param TileName - The name of the tile in grid format (e.g., "A1").
-	 * @return A weak pointer to the tile, or nullptr if not found.
+	 * Returns the display name of a tile (e.g., "A1"). Names are meant for the UI only.
+	 * @param Coord - The coordinate of the tile.
+	 * @return The tile name, or an empty string if the coordinate lies outside the grid.
 	 */
 	UFUNCTION()
-	TWeakObjectPtr<ATile> GetTile(const FString& TileName) const;
+	FString GetTileName(const FGridCoord& Coord) const;
 
 	/**
-	 * Retrieves the names of neighboring tiles for a given tile.
-	 * @param TileName - The name of the tile in grid format (e.g., "A1").
-	 * @return An array of neighboring tile names.
+	 * Retrieves a tile from the grid using its coordinate.
+	 * @param Coord - The coordinate of the tile.
+	 * @return A weak pointer to the tile, or nullptr if not found or if the grid is rendered as instances.
 	 */
 	UFUNCTION()
-	TArray<FString> GetNeighbours(const FString& TileName) const;
-	
+	TWeakObjectPtr<ATile> GetTile(const FGridCoord& Coord) const;
+
 	/**
-	 * Finds a path from a start tile to an end tile using the A* algorithm.
-	 * @param StartTile - The name of the starting tile.
-	 * @param EndTile - The name of the destination tile.
-	 * @param OccupiedTiles - A list of tiles that are currently occupied and cannot be traversed.
-	 * @return An array of tile names representing the path from start to end.
+	 * Finds the tile under a ray (e.g. the cursor's) analytically, by intersecting it with the plane of the grid.
+	 * Cheap enough to run every frame, and independent of collision, which tiles and units do not have.
+	 * @param RayOrigin - The world origin of the ray.
+	 * @param RayDirection - The world direction of the ray.
+	 * @return The coordinate of the tile, or an unset coordinate if the ray misses the grid.
+	 */
+	FGridCoord PickTile(const FVector& RayOrigin, const FVector& RayDirection) const;
+
+	/**
+	 * Returns whether a tile is an obstacle.
+	 * @param Coord - The coordinate of the tile.
+	 * @return True if the tile is an obstacle or lies outside the grid.
+	 */
+	UFUNCTION()
+	bool IsObstacle(const FGridCoord& Coord) const;
+
+	/**
+	 * Retrieves the coordinates of neighboring tiles for a given tile.
+	 * @param Coord - The coordinate of the tile.
+	 * @return An array of neighboring tile coordinates.
 	 */
 	UFUNCTION()
-	TArray<FString> FindPath(const FString& StartTile, const FString& EndTile, const TArray<FString>& OccupiedTiles) const;
+	TArray<FGridCoord> GetNeighbours(const FGridCoord& Coord) const;
+	
+	/**
+	 * Finds a path from a start tile to an end tile using the configured search (A* or Jump Point Search),
+	 * or the sector hierarchy for distant tiles when hierarchical pathfinding is enabled.
+	 * @param StartTile - The coordinate of the starting tile.
+	 * @param EndTile - The coordinate of the destination tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @return An array of tile coordinates representing the path from start to end.
+	 */
+	TArray<FGridCoord> FindPath(const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied) const;
 
 	/**
-	 * Finds all tiles within a specified range from a center tile using BFS.
-	 * @param CenterTile - The name of the center tile.
+	 * Finds all tiles within a specified range from a center tile; with obstacles considered, the range is in movement points.
+	 * @param CenterTile - The coordinate of the center tile.
 	 * @param Size - The maximum distance (in tiles) from the center tile.
 	 * @param ConsiderObstacles - Whether to consider obstacles and occupied tiles.
-	 * @param OccupiedTiles - A list of tiles that are currently occupied and cannot be traversed.
-	 * @return An array of tile names representing the reachable area.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @return An array of tile coordinates representing the reachable area.
 	 */
-	UFUNCTION()
-	TArray<FString> FindArea(const FString& CenterTile, const int32 Size, const bool ConsiderObstacles, const TArray<FString>& OccupiedTiles) const;
+	TArray<FGridCoord> FindArea(const FGridCoord& CenterTile, const int32 Size, const bool ConsiderObstacles, const TBitArray<>& Occupied) const;
+
+	/**
+	 * Same as FindArea, but returns a view into the grid's reusable buffer instead of a copy.
+	 * The view is only valid until the next area query on this grid.
+	 */
+	TConstArrayView<FGridCoord> FindAreaView(const FGridCoord& CenterTile, const int32 Size, const bool ConsiderObstacles, const TBitArray<>& Occupied) const;
+
+	/**
+	 * Builds the cached distance field of every unit position, so the turn only performs lookups.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed; its set bits are the unit positions.
+	 */
+	void WarmDistanceFields(const TBitArray<>& Occupied) const;
+
+	/**
+	 * Finds all tiles a unit can walk to with a given number of movement points, using the cached distance field of its tile.
+	 * Unlike FindArea this does not search again while the field is valid; occupancy changes must be reported
+	 * through NotifyOccupancyChanged.
+	 * @param UnitTile - The coordinate of the unit's tile.
+	 * @param Range - The movement points.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @return A view of the reachable tiles, valid until the next movement range query on this grid.
+	 */
+	TConstArrayView<FGridCoord> FindMovementRange(const FGridCoord& UnitTile, const int32 Range, const TBitArray<>& Occupied) const;
+
+	/**
+	 * Returns the walking distance between two tiles using the cached distance field of the source tile.
+	 * @param SourceTile - The coordinate of the tile the field is built from (usually a unit's tile).
+	 * @param TargetTile - The coordinate of the tile to look up.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @return The movement points needed, or INDEX_NONE if the target cannot be reached.
+	 */
+	int32 GetPathDistance(const FGridCoord& SourceTile, const FGridCoord& TargetTile, const TBitArray<>& Occupied) const;
+
+	/**
+	 * Drops the cached distance fields affected by a tile becoming occupied or free.
+	 * @param Coord - The coordinate of the tile whose occupancy changed.
+	 */
+	void NotifyOccupancyChanged(const FGridCoord& Coord) const;
 
 	/**
 	 * Colors a list of tiles with a specified color.
-	 * @param Tiles - The list of tile names to color.
+	 * The change is recorded and applied with every other color change at the next frame flush.
+	 * @param Tiles - The list of tile coordinates to color.
 	 * @param Color - The color to apply to the tiles.
 	 */
 	UFUNCTION()
-	void ColorTiles(TArray<FString>& Tiles, const FLinearColor Color) const;
+	void ColorTiles(const TArray<FGridCoord>& Tiles, const FLinearColor Color);
+
+	/**
+	 * Replaces the highlighted tile set. Tiles leaving the set go back to their heatmap tint, tiles entering it take the color;
+	 * tiles in both sets with an unchanged color are not touched when the change is flushed.
+	 * @param Tiles - The new set of highlighted tile coordinates.
+	 * @param Color - The highlight color.
+	 */
+	void SetHighlight(const TArray<FGridCoord>& Tiles, const FLinearColor Color);
+
+	/**
+	 * Removes the current highlight and path preview, turning their tiles back to their heatmap tint at the next flush.
+	 */
+	void ClearHighlight();
+
+	/**
+	 * Replaces the previewed path, drawn over the highlight. Tiles leaving the preview go back to the highlight
+	 * color if they are part of it, or to their heatmap tint; a new highlight drops the preview.
+	 * @param Path - The tiles of the path; empty removes the preview.
+	 * @param Color - The preview color.
+	 */
+	void SetPathPreview(TConstArrayView<FGridCoord> Path, const FLinearColor& Color);
+
+	/**
+	 * Tints every tile by a weight, from white (0) to a color (1), e.g. to debug an influence map. Tiles under the highlight
+	 * or path preview keep showing it and take their tint once it leaves them.
+	 * @param Weights - One weight in [0, 1] per cell, by flat index; an empty view turns the tiles back to white.
+	 * @param Color - The color of a full weight.
+	 */
+	void SetHeatmap(TConstArrayView<float> Weights, const FLinearColor& Color);
+
+	/**
+	 * Returns the integer-indexed grid model shared by the grid utilities.
+	 * @return The grid data.
+	 */
+	const FGridData& GetGridData() const;
 
 	/**
 	 * Returns the width of the grid.
@@ -133,6 +265,11 @@ protected:
 	 */
 	UFUNCTION()
 	virtual void BeginPlay() override;
+
+	/**
+	 * Flushes the pending tile color changes; only ticks on frames where something changed.
+	 */
+	virtual void Tick(float DeltaTime) override;
 	
 private:
 	/**
@@ -154,6 +291,81 @@ private:
 	UPROPERTY(EditAnywhere)
 	float ObstaclePercentage = 0.3f; // The percentage of tiles to be obstacles (0.0 to 1.0).
 
+	UPROPERTY(EditAnywhere)
+	int32 ObstacleSeed = 0; // The seed of the obstacle layout; 0 takes it from the match's obstacle stream.
+
+	TWeakObjectPtr<AStrategyGameMode> GameMode; // The game mode owning the match random streams.
+
+	FGridData Grid; // The flat grid model (obstacles, movement costs and tile handles).
+
+	mutable FGridSearchScratch SearchScratch; // Reusable search state shared by every path query on this grid.
+
+	mutable FGridFloodScratch FloodScratch; // Reusable buffers shared by every area query on this grid.
+
+	UPROPERTY(EditAnywhere)
+	EGridPathSearch PathSearch = EGridPathSearch::AStar; // The search behind FindPath when the hierarchy does not answer it.
+
+	UPROPERTY(EditAnywhere)
+	bool bUseHierarchicalPathfinding = false; // Whether distant path queries go through the sector hierarchy (HPA*); worth it on large maps.
+
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "bUseHierarchicalPathfinding", ClampMin = "4"))
+	int32 HierarchyClusterSize = 16; // The width and height of a hierarchy sector, in tiles.
+
+	mutable FGridHierarchy Hierarchy; // The abstract graph of the sectors; rebuilt with the obstacles, repaired on occupancy changes.
+
+	/**
+	 * Rebuilds the sector hierarchy against the current obstacles if hierarchical pathfinding is enabled.
+	 */
+	void RebuildHierarchy();
+
 	UPROPERTY()
-	TMap<FString, TWeakObjectPtr<ATile>> TileMap; // A map of tile names to tile objects.
+	UDistanceFieldCache* DistanceFields = nullptr; // Cached distance fields of the battle phase.
+
+	/**
+	 * Pushes the obstacle mask to the tile instances with a single render state update.
+	 */
+	void SyncInstanceObstacles() const;
+
+	UPROPERTY(EditAnywhere)
+	EGridRenderMode RenderMode = EGridRenderMode::Actors; // How the tiles are rendered; Instanced also needs InstancedTileMaterial.
+
+	UPROPERTY(EditAnywhere)
+	UMaterialInterface* InstancedTileMaterial = nullptr; // Tile material reading per-instance custom data (BaseColor, TextureIndex, bIsObstacle), used in instanced mode.
+
+	UPROPERTY(VisibleAnywhere)
+	UInstancedStaticMeshComponent* TileInstances = nullptr; // One instance per cell, in flat index order, in instanced mode.
+
+	bool bUseInstances = false; // Whether the current grid was generated as instances.
+
+	/**
+	 * Records the color a tile should show and schedules it for the next flush.
+	 * @param Index - The flat index of the tile.
+	 * @param Color - The color the tile should show.
+	 */
+	void RequestTileColor(const int32 Index, const FLinearColor& Color);
+
+	/**
+	 * Applies every pending color change whose value differs from what the tile currently shows.
+	 */
+	void FlushTileColors();
+
+	TArray<FLinearColor> DisplayedColors; // The color each tile currently shows.
+
+	TArray<FLinearColor> RequestedColors; // The color each tile should show after the next flush.
+
+	TArray<int32> DirtyTiles; // Tiles whose requested color may differ from the displayed one.
+
+	TBitArray<> DirtyMask; // One bit per tile, set while the tile is in DirtyTiles.
+
+	TArray<int32> HighlightedTiles; // The tiles of the current highlight set.
+
+	TBitArray<> HighlightMask; // One bit per tile, set while the tile is in HighlightedTiles.
+
+	FLinearColor HighlightColor = FLinearColor::White; // The color of the current highlight set.
+
+	TArray<int32> PreviewTiles; // The tiles of the current path preview.
+
+	TBitArray<> PreviewMask; // One bit per tile, set while the tile is in PreviewTiles.
+
+	TArray<FLinearColor> BaseColors; // The heatmap tint of each tile, white without a heatmap; shown where nothing is drawn over it.
 };
\ No newline at end of file
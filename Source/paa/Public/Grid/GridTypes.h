@@ -0,0 +1,141 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridTypes.generated.h"
+
+// Forward Declarations
+class ATile;
+
+/**
+ * FGridCoord identifies a single cell of the grid by column (X) and row (Y).
+ * Column 0 / row 0 corresponds to the tile named "A1"; names are only produced for display.
+ * A default-constructed coordinate is unset and never belongs to a grid.
+ */
+USTRUCT()
+struct PAA_API FGridCoord
+{
+	GENERATED_BODY()
+
+	FGridCoord() = default;
+	FGridCoord(const int32 InX, const int32 InY) : X(InX), Y(InY) {}
+
+	UPROPERTY(VisibleAnywhere)
+	int32 X = INDEX_NONE; // The column of the cell (the letter in "A1").
+
+	UPROPERTY(VisibleAnywhere)
+	int32 Y = INDEX_NONE; // The row of the cell (the number in "A1", zero-based).
+
+	/**
+	 * Returns whether the coordinate has been assigned (it may still be outside a given grid).
+	 * @return True if both components are non-negative.
+	 */
+	bool IsSet() const { return X >= 0 && Y >= 0; }
+
+	/**
+	 * Returns the Manhattan distance between two coordinates.
+	 * @param Other - The other coordinate.
+	 * @return The number of orthogonal steps between the two cells.
+	 */
+	int32 Distance(const FGridCoord& Other) const { return FMath::Abs(X - Other.X) + FMath::Abs(Y - Other.Y); }
+
+	bool operator==(const FGridCoord& Other) const { return X == Other.X && Y == Other.Y; }
+	bool operator!=(const FGridCoord& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FGridCoord& Coord) { return HashCombine(::GetTypeHash(Coord.X), ::GetTypeHash(Coord.Y)); }
+};
+
+/**
+ * FGridData is the dense, integer-indexed model of the grid.
+ * Cells are stored row-major (Index = Y * SizeX + X) as a struct of arrays so that
+ * searches only touch the layers they need.
+ */
+struct PAA_API FGridData
+{
+	int32 SizeX = 0; // The width of the grid.
+	int32 SizeY = 0; // The height of the grid.
+
+	TBitArray<> Obstacles; // One bit per cell, set when the cell is an obstacle.
+	TArray<uint8> MovementCost; // The cost of entering each cell, at least 1; written through SetMovementCost(s).
+	TArray<TWeakObjectPtr<ATile>> Tiles; // The tile actor representing each cell.
+	uint8 MaxMovementCost = 1; // An upper bound of every movement cost; 1 means the grid is uniform-cost.
+
+	/**
+	 * Resizes every layer for a grid of the given dimensions and resets it to walkable, unit-cost, tile-less cells.
+	 * @param InSizeX - The width of the grid.
+	 * @param InSizeY - The height of the grid.
+	 */
+	void Init(const int32 InSizeX, const int32 InSizeY)
+	{
+		SizeX = InSizeX;
+		SizeY = InSizeY;
+		Obstacles.Init(false, Num());
+		MovementCost.Init(1, Num());
+		Tiles.Init(nullptr, Num());
+		MaxMovementCost = 1;
+	}
+
+	/**
+	 * Sets the cost of entering a cell.
+	 * @param Index - The flat index of the cell.
+	 * @param Cost - The cost, raised to 1 if lower.
+	 */
+	void SetMovementCost(const int32 Index, const uint8 Cost)
+	{
+		MovementCost[Index] = FMath::Max<uint8>(Cost, 1);
+		MaxMovementCost = FMath::Max(MaxMovementCost, MovementCost[Index]);
+	}
+
+	/**
+	 * Replaces every movement cost.
+	 * @param Costs - One cost per cell, raised to 1 if lower; empty makes every cell cost 1.
+	 */
+	void SetMovementCosts(const TArray<uint8>& Costs)
+	{
+		check(Costs.Num() == 0 || Costs.Num() == Num());
+
+		MovementCost.Init(1, Num());
+		MaxMovementCost = 1;
+		for (int32 Index = 0; Index < Costs.Num(); ++Index) SetMovementCost(Index, Costs[Index]);
+	}
+
+	/** @return True if every cell costs 1 to enter, so plain BFS and unit-cost searches apply. */
+	bool IsUniformCost() const { return MaxMovementCost <= 1; }
+
+	/** @return The total number of cells. */
+	int32 Num() const { return SizeX * SizeY; }
+
+	/** @return True if the coordinate lies inside the grid. */
+	bool IsInside(const FGridCoord& Coord) const { return Coord.X >= 0 && Coord.X < SizeX && Coord.Y >= 0 && Coord.Y < SizeY; }
+
+	/** @return True if the flat index lies inside the grid. */
+	bool IsValidIndex(const int32 Index) const { return Index >= 0 && Index < Num(); }
+
+	/** @return The flat index of a coordinate, or INDEX_NONE if it lies outside the grid. */
+	int32 ToIndex(const FGridCoord& Coord) const { return IsInside(Coord) ? Coord.Y * SizeX + Coord.X : INDEX_NONE; }
+
+	/** @return The coordinate of a flat index. */
+	FGridCoord ToCoord(const int32 Index) const { return FGridCoord(Index % SizeX, Index / SizeX); }
+
+	/** @return True if the cell at the flat index is an obstacle. */
+	bool IsObstacle(const int32 Index) const { return Obstacles[Index]; }
+
+	/**
+	 * Collects the orthogonal neighbours of a cell (north, south, west, east), skipping cells outside the grid.
+	 * @param Index - The flat index of the cell.
+	 * @param OutNeighbors - Receives the flat indices of the neighbours.
+	 * @return The number of neighbours written.
+	 */
+	int32 GetNeighbors(const int32 Index, int32 (&OutNeighbors)[4]) const
+	{
+		const int32 X = Index % SizeX;
+		const int32 Y = Index / SizeX;
+		int32 Count = 0;
+
+		if (Y > 0) OutNeighbors[Count++] = Index - SizeX; // North
+		if (Y < SizeY - 1) OutNeighbors[Count++] = Index + SizeX; // South
+		if (X > 0) OutNeighbors[Count++] = Index - 1; // West
+		if (X < SizeX - 1) OutNeighbors[Count++] = Index + 1; // East
+
+		return Count;
+	}
+};
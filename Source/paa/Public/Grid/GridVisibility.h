@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/GridBitboard.h"
+#include "Grid/GridTypes.h"
+
+/**
+ * FGridVisibility answers line-of-sight questions between tiles: a ranged attack needs a clear line from the
+ * attacker's tile to the target's tile. Rays walk every cell the segment between the two tile centers touches
+ * (a supercover line), and an obstacle on any of them blocks the view; a ray squeezing exactly through the corner
+ * between two cells is only blocked if both cells are obstacles. Units never block the view, and the tiles at both
+ * ends do not count, so A sees B exactly when B sees A.
+ * Build caches, for every tile, the tiles it sees within a Manhattan range as one bit mask per row, so attacks
+ * check visibility with a single lookup and whole visible areas can be ORed into a bitboard a row at a time.
+ */
+struct PAA_API FGridVisibility
+{
+	static constexpr int32 MaxRange = 15; // The largest cached range; a row of the box fits in 32 bits.
+	static constexpr int32 MaxCachedCells = 64 * 64; // Larger grids are not cached and cast rays on demand.
+
+	/**
+	 * Casts a ray between two tiles over the grid's obstacles.
+	 * @param Grid - The grid data.
+	 * @param From - The coordinate of the first tile.
+	 * @param To - The coordinate of the second tile.
+	 * @return True if no obstacle lies between the two tiles; false if either tile is outside the grid.
+	 */
+	static bool HasLineOfSight(const FGridData& Grid, const FGridCoord& From, const FGridCoord& To);
+
+	/**
+	 * Caches the visible tiles of every tile within a range, after the obstacles of the grid were placed.
+	 * Grids larger than MaxCachedCells are left uncached.
+	 * @param Grid - The grid data.
+	 * @param InRange - The Manhattan range to cache, clamped to MaxRange.
+	 */
+	void Build(const FGridData& Grid, const int32 InRange);
+
+	/** Drops the cache; every query casts rays until the next Build. */
+	void Reset();
+
+	/** @return True if the cache was built and answers queries within GetRange with a lookup. */
+	bool IsBuilt() const { return Range > 0; }
+
+	/** @return The cached Manhattan range, or 0 if the cache is not built. */
+	int32 GetRange() const { return Range; }
+
+	/**
+	 * Returns whether two tiles see each other, from the cache when they are within the cached range.
+	 * @param Grid - The grid data the cache was built from.
+	 * @param From - The coordinate of the first tile.
+	 * @param To - The coordinate of the second tile.
+	 * @return True if no obstacle lies between the two tiles.
+	 */
+	bool IsVisible(const FGridData& Grid, const FGridCoord& From, const FGridCoord& To) const;
+
+	/**
+	 * Adds every tile within a Manhattan range of a tile that sees it, e.g. every tile a unit could shoot it from.
+	 * @param Grid - The grid data the cache was built from.
+	 * @param Center - The coordinate of the tile.
+	 * @param InRange - The Manhattan range.
+	 * @param InOutArea - The set receiving the tiles; must have the size of the grid.
+	 */
+	void AddVisibleArea(const FGridData& Grid, const FGridCoord& Center, const int32 InRange, FGridBitboard& InOutArea) const;
+
+private:
+	/** @return The cached row mask of a tile for a row offset within [-Range, Range]; bit Range + dx is the tile at dx. */
+	uint32 GetRowMask(const int32 Cell, const int32 OffsetY) const { return RowMasks[Cell * Span + OffsetY + Range]; }
+
+	int32 Range = 0; // The cached Manhattan range.
+	int32 Span = 0; // The number of rows and columns of the box around a tile, 2 * Range + 1.
+	TArray<uint32> RowMasks; // Span row masks per cell, top row first.
+};
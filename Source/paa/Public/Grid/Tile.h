@@ -65,6 +65,14 @@ public:
 	UFUNCTION()
     void UpdateMaterial() const;
 
+    /**
+     * @brief Updates only the base color parameter of the dynamic material.
+     *
+     * Used by the grid's batched recolouring, which never changes the other parameters.
+     */
+	UFUNCTION()
+    void UpdateBaseColor() const;
+
 protected:
     /**
      * @brief Called when the actor is constructed or modified in the editor.
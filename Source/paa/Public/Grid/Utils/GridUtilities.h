@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Grid/GridTypes.h"
 #include "Grid/Tile.h"
 #include "GridUtilities.Generated.h"
 
@@ -16,32 +17,43 @@ class PAA_API UGridUtilities final : public UObject
 	
 public:
 	/**
-	 * Retrieves a tile from the tile map using its name.
-	 * @param TileMap - The map of tile names to tile objects.
-	 * @param TileName - The name of the tile to retrieve.
+	 * Retrieves a tile from the grid using its coordinate.
+	 * @param Grid - The grid data.
+	 * @param Coord - The coordinate of the tile to retrieve.
 	 * @return A weak pointer to the tile, or nullptr if not found.
 	 */
-	static TWeakObjectPtr<ATile> GetTile(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const FString& TileName);
+	static TWeakObjectPtr<ATile> GetTile(const FGridData& Grid, const FGridCoord& Coord);
 	
 	/**
-	 * Converts a grid coordinate (e.g., "A1") to a world position.
-	 * @param TileName - The name of the tile in grid format (e.g., "A1").
+	 * Converts a grid coordinate to a world position.
+	 * @param Coord - The coordinate of the tile.
 	 * @param GridSizeX - The width of the grid.
 	 * @param GridSizeY - The height of the grid.
 	 * @param TileSize - The size of each tile in world units.
 	 * @return The world position of the tile.
 	 */
-	static FVector GridToWorld(const FString& TileName, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
+	static FVector GridToWorld(const FGridCoord& Coord, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
 
 	/**
-	 * Converts a world position to a grid coordinate (e.g., "A1").
+	 * Converts a world position to a grid coordinate.
 	 * @param TilePosition - The world position of the tile.
 	 * @param GridSizeX - The width of the grid.
 	 * @param GridSizeY - The height of the grid.
 	 * @param TileSize - The size of each tile in world units.
-	 * @return The grid coordinate as a string (e.g., "A1").
+	 * @return The grid coordinate, or an unset coordinate if the position lies outside the grid.
 	 */
-	static FString WorldToGrid(const FVector& TilePosition, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
+	static FGridCoord WorldToGrid(const FVector& TilePosition, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
+
+	/**
+	 * Intersects a ray with the plane of the grid (Z = 0, in the grid's space) and returns the tile it crosses it on.
+	 * @param RayOrigin - The origin of the ray.
+	 * @param RayDirection - The direction of the ray.
+	 * @param GridSizeX - The width of the grid.
+	 * @param GridSizeY - The height of the grid.
+	 * @param TileSize - The size of each tile in world units.
+	 * @return The grid coordinate, or an unset coordinate if the ray misses the grid.
+	 */
+	static FGridCoord RayToGrid(const FVector& RayOrigin, const FVector& RayDirection, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
 
 	/**
 	 * Generates a tile name from grid coordinates (e.g., "A1").
@@ -65,23 +77,18 @@ public:
 	static FVector GetCoordinate(const int32 X, const int32 Y, const int32 GridSizeX, const  int32 GridSizeY, const float TileSize);
 
 	/**
-	 * Retrieves the names of neighboring tiles for a given tile.
-	 * @param TileName - The name of the tile in grid format (e.g., "A1").
-	 * @param GridSizeX - The width of the grid.
-	 * @param GridSizeY - The height of the grid.
-	 * @param TileSize - The size of each tile in world units.
-	 * @return An array of neighboring tile names.
+	 * Retrieves the coordinates of the tiles neighboring a given tile.
+	 * @param Grid - The grid data.
+	 * @param Coord - The coordinate of the tile.
+	 * @return An array of neighboring tile coordinates.
 	 */
-	static TArray<FString> GetNeighborsName(const FString& TileName, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
+	static TArray<FGridCoord> GetNeighbors(const FGridData& Grid, const FGridCoord& Coord);
 
 	/**
-	 * Retrieves the neighboring tiles for a given tile.
-	 * @param TileMap - The map of tile names to tile objects.
-	 * @param TileName - The name of the tile in grid format (e.g., "A1").
-	 * @param GridSizeX - The width of the grid.
-	 * @param GridSizeY - The height of the grid.
-	 * @param TileSize - The size of each tile in world units.
-	 * @return An array of weak pointers to neighboring tiles.
+	 * Builds a per-cell mask with a bit set for every listed coordinate that lies inside the grid.
+	 * @param Grid - The grid data.
+	 * @param Coords - The coordinates to mark.
+	 * @return A bit array with one bit per cell.
 	 */
-	static TArray<TWeakObjectPtr<ATile>> GetNeighbors(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const FString& TileName, const int32 GridSizeX, const int32 GridSizeY, const float TileSize);
-};
\ No newline at end of file
+	static TBitArray<> MakeMask(const FGridData& Grid, const TArray<FGridCoord>& Coords);
+};
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Grid/GridTypes.h"
 #include "Grid/Tile.h"
+#include "Game/MatchRandom.h"
 #include "ObstaclesUtilities.generated.h"
 
 /**
  * UObstaclesUtilities provides utility functions for generating and managing obstacles on a grid.
- * It includes functions for resetting tiles, generating obstacles, and performing depth-first search (DFS) for obstacle placement.
+ * Obstacles are carved on the flat obstacle mask first and only then pushed to the tile actors in one pass.
  */
 UCLASS()
 class PAA_API UObstaclesUtilities : public UObject
@@ -15,31 +17,39 @@ class PAA_API UObstaclesUtilities : public UObject
 	
 public:
 	/**
-	 * Resets all tiles in the grid to their default state (no obstacles).
-	 * @param TileMap - The map of tile names to tile objects.
+	 * Resets all tiles in the grid to their default state (obstacles).
+	 * @param Grid - The grid data.
 	 */
-	static void ResetTiles(TMap<FString, TWeakObjectPtr<ATile>>& TileMap);
+	static void ResetTiles(FGridData& Grid);
 
 	/**
-	 * Generates obstacles on the grid based on a specified percentage.
-	 * @param TileMap - The map of tile names to tile objects.
-	 * @param GridSizeX - The width of the grid.
-	 * @param GridSizeY - The height of the grid.
-	 * @param TileSize - The size of each tile in world units.
+	 * Generates obstacles on the grid based on a specified percentage and updates the tile actors.
+	 * @param Grid - The grid data.
 	 * @param ObstaclePercentage - The percentage of tiles to be obstacles (0.0 to 1.0).
+	 * @param Seed - The seed of the generation; the same seed always produces the same obstacles.
 	 */
-	static void GenerateObstacles(TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const int32 GridSizeX, const int32 GridSizeY, const float TileSize, const float ObstaclePercentage);
+	static void GenerateObstacles(FGridData& Grid, const float ObstaclePercentage, const int32 Seed);
 
-private:
 	/**
-	 * Performs a depth-first search (DFS) to generate obstacles on the grid.
-	 * @param TileMap - The map of tile names to tile objects.
-	 * @param Explored - A list of tiles that have already been processed.
-	 * @param Current - The current tile being processed.
-	 * @param GridSizeX - The width of the grid.
-	 * @param GridSizeY - The height of the grid.
-	 * @param TileSize - The size of each tile in world units.
-	 * @param TotalObstacles - The total number of obstacles to generate.
+	 * Fills the obstacle mask and carves the free tiles out of it with an iterative randomized depth-first search.
+	 * Every carved tile touches a previously carved one, so the free tiles always form a single connected region.
+	 * Tile actors are not touched.
+	 * @param Grid - The grid data.
+	 * @param ObstaclePercentage - The percentage of tiles to be obstacles (0.0 to 1.0).
+	 * @param Stream - The random stream driving the carve.
+	 */
+	static void CarveObstacles(FGridData& Grid, const float ObstaclePercentage, FMatchRng& Stream);
+
+	/**
+	 * Checks that every free tile can be reached from every other free tile.
+	 * @param Grid - The grid data.
+	 * @return True if the free tiles form a single connected region (or there are none).
+	 */
+	static bool AreFreeTilesConnected(const FGridData& Grid);
+
+	/**
+	 * Mirrors the obstacle mask onto the tile actors, updating only the tiles whose state changed.
+	 * @param Grid - The grid data.
 	 */
-	static void DFS(TMap<FString, TWeakObjectPtr<ATile>>& TileMap, TArray<FString>& Explored, const FString& Current, const int32 GridSizeX, const int32 GridSizeY, const float TileSize, const int32 TotalObstacles);
-};
\ No newline at end of file
+	static void SyncTiles(const FGridData& Grid);
+};
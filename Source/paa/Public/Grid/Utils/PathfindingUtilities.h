@@ -1,9 +1,192 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Grid/GridTypes.h"
+#include "Grid/GridBitboard.h"
 #include "Grid/Tile.h"
 #include "PathfindingUtilities.generated.h"
 
+/**
+ * FGridSearchScratch holds the per-cell bookkeeping of a grid search so that it can be reused across queries.
+ * Cells are tagged with the generation of the search that last wrote them, which makes starting a new
+ * search O(1) instead of clearing every array. One instance belongs to each grid and is not thread-safe.
+ */
+struct PAA_API FGridSearchScratch
+{
+	/** An entry of the open list; stale entries are skipped lazily when popped. */
+	struct FOpenNode
+	{
+		int32 F; // Estimated total cost through the cell.
+		int32 H; // Heuristic part of F, used to break ties toward the goal.
+		int32 Index; // The flat index of the cell.
+	};
+
+	/** Orders the open list by lowest F, then lowest H. */
+	struct FOpenNodePredicate
+	{
+		bool operator()(const FOpenNode& A, const FOpenNode& B) const
+		{
+			return A.F < B.F || (A.F == B.F && A.H < B.H);
+		}
+	};
+
+	TArray<int32> GScore; // The best known cost from the start to each cell.
+	TArray<int32> Parent; // The cell each cell was reached from.
+	TArray<int32> Turns; // The number of direction changes on the best known path to each cell.
+	TArray<uint32> OpenStamp; // The generation in which each cell was first reached.
+	TArray<uint32> ClosedStamp; // The generation in which each cell was expanded.
+	TArray<FOpenNode> Heap; // The open list, kept as a binary heap.
+	uint32 Generation = 0; // The generation of the current search.
+
+	/**
+	 * Prepares the scratch data for a new search over a grid with the given number of cells.
+	 * @param NumCells - The number of cells in the grid.
+	 */
+	void Begin(const int32 NumCells)
+	{
+		if (OpenStamp.Num() != NumCells)
+		{
+			GScore.SetNumUninitialized(NumCells);
+			Parent.SetNumUninitialized(NumCells);
+			Turns.SetNumUninitialized(NumCells);
+			OpenStamp.Init(0, NumCells);
+			ClosedStamp.Init(0, NumCells);
+			Generation = 0;
+		}
+
+		// Stamps are only cleared when the generation counter wraps around.
+		if (++Generation == 0)
+		{
+			OpenStamp.Init(0, NumCells);
+			ClosedStamp.Init(0, NumCells);
+			Generation = 1;
+		}
+
+		Heap.Reset();
+	}
+
+	bool IsOpened(const int32 Index) const { return OpenStamp[Index] == Generation; }
+	bool IsClosed(const int32 Index) const { return ClosedStamp[Index] == Generation; }
+	void Close(const int32 Index) { ClosedStamp[Index] = Generation; }
+
+	/** Records the best known way of reaching a cell. */
+	void Reach(const int32 Index, const int32 G, const int32 From, const int32 TurnCount)
+	{
+		OpenStamp[Index] = Generation;
+		GScore[Index] = G;
+		Parent[Index] = From;
+		Turns[Index] = TurnCount;
+	}
+};
+
+/**
+ * FGridBucketQueue is the priority queue of the searches over movement costs (Dial's algorithm).
+ * Costs are small integers, so cells wait in one bucket per distance, modulo the largest step cost plus one,
+ * and come out in distance order without a heap. Superseded entries stay queued; callers skip them when popped.
+ */
+struct PAA_API FGridBucketQueue
+{
+	/**
+	 * Empties the queue for a new search.
+	 * @param MaxStepCost - The largest cost of a single step.
+	 */
+	void Begin(const int32 MaxStepCost)
+	{
+		NumBuckets = MaxStepCost + 1;
+		if (Buckets.Num() < NumBuckets) Buckets.SetNum(NumBuckets);
+		for (TArray<int32>& Bucket : Buckets) Bucket.Reset();
+
+		Distance = 0;
+		Count = 0;
+	}
+
+	/**
+	 * Queues a cell; its distance may not be lower than the last one popped, nor a step cost beyond it.
+	 * @param Cell - The flat index of the cell.
+	 * @param CellDistance - The distance of the cell.
+	 */
+	void Push(const int32 Cell, const int32 CellDistance)
+	{
+		check(CellDistance >= Distance && CellDistance - Distance < NumBuckets);
+		Buckets[CellDistance % NumBuckets].Add(Cell);
+		++Count;
+	}
+
+	/**
+	 * Takes a cell of the lowest queued distance.
+	 * @param OutCell - Receives the flat index of the cell.
+	 * @param OutDistance - Receives the distance it was queued with.
+	 * @return False if the queue is empty.
+	 */
+	bool Pop(int32& OutCell, int32& OutDistance)
+	{
+		if (Count == 0) return false;
+
+		while (Buckets[Distance % NumBuckets].Num() == 0) ++Distance;
+
+		OutCell = Buckets[Distance % NumBuckets].Pop(EAllowShrinking::No);
+		OutDistance = Distance;
+		--Count;
+		return true;
+	}
+
+private:
+	TArray<TArray<int32>> Buckets; // The cells waiting at each distance, modulo NumBuckets.
+	int32 NumBuckets = 0; // The number of buckets in use.
+	int32 Distance = 0; // The distance of the last popped cell.
+	int32 Count = 0; // The number of queued entries.
+};
+
+/**
+ * FGridFloodScratch holds the reusable buffers of the area queries.
+ * One instance belongs to each grid; the area it returns stays valid until the next query on that grid.
+ */
+struct PAA_API FGridFloodScratch
+{
+	FGridBitboard Walkable; // The free tiles of the last query.
+	FGridBitboard Reach; // The area of the last query, as a set.
+	FGridBucketQueue Queue; // The open cells of a search over movement costs.
+	TArray<int32> Distance; // The movement points spent to reach each cell; INDEX_NONE outside a search.
+	TArray<FGridCoord> Area; // The result of the last query.
+};
+
+/**
+ * FGridPathTree is the shortest-path tree of one Dijkstra search from a source tile, bounded by movement points.
+ * Every reached cell keeps its distance and the cell it was entered from, so the path to any of them is a walk up
+ * the parents instead of a new search. A tree only holds for the obstacles and occupancy it was built with;
+ * its owner resets it when either changes.
+ */
+struct PAA_API FGridPathTree
+{
+	/**
+	 * Drops the tree; the buffers are kept for the next build.
+	 */
+	void Reset() { Source = INDEX_NONE; }
+
+	/**
+	 * Returns whether the tree was built from a source with a number of movement points, and not reset since.
+	 * @param InSource - The flat index of the source tile.
+	 * @param InRange - The movement points.
+	 * @return True if the tree can answer paths from that source.
+	 */
+	bool IsBuiltFrom(const int32 InSource, const int32 InRange) const { return Source != INDEX_NONE && Source == InSource && Range == InRange; }
+
+	/**
+	 * Walks the parents from a tile back to the source.
+	 * @param Grid - The grid data the tree was built on.
+	 * @param Target - The flat index of the tile.
+	 * @param OutPath - Receives the tiles from the source to the target, both included; emptied if the tile was not reached.
+	 * @return True if the tile was reached.
+	 */
+	bool GetPath(const FGridData& Grid, const int32 Target, TArray<FGridCoord>& OutPath) const;
+
+	int32 Source = INDEX_NONE; // The flat index of the source tile, INDEX_NONE if the tree is not built.
+	int32 Range = 0; // The movement points the search was bounded by.
+	TArray<int32> Distance; // The movement points spent to reach each cell; INDEX_NONE if it was not reached.
+	TArray<int32> Parent; // The cell each cell was entered from; INDEX_NONE for the source and unreached cells.
+	FGridBucketQueue Queue; // The open cells of the search.
+};
+
 /**
  * UPathfindingUtilities provides utility functions for pathfinding and area exploration on a grid.
  * It includes functions for finding paths between tiles using A* and exploring areas using BFS.
@@ -15,29 +198,80 @@ class PAA_API UPathfindingUtilities : public UObject
 	
 public:
 	/**
-	 * Finds a path from a start tile to an end tile using the A* algorithm.
-	 * @param TileMap - The map of tile names to tile objects.
-	 * @param StartTile - The name of the starting tile.
-	 * @param EndTile - The name of the destination tile.
-	 * @param GridSizeX - The width of the grid.
-	 * @param GridSizeY - The height of the grid.
-	 * @param TileSize - The size of each tile in world units.
-	 * @param OccupiedTiles - A list of tiles that are currently occupied and cannot be traversed.
-	 * @return An array of tile names representing the path from start to end.
+	 * Finds a path from a start tile to an end tile using the A* algorithm, paying the movement cost of every tile entered.
+	 * The open list is a binary heap with lazy deletion; among equally cheap paths the one with fewer turns is preferred.
+	 * @param Grid - The grid data.
+	 * @param StartTile - The coordinate of the starting tile.
+	 * @param EndTile - The coordinate of the destination tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param Scratch - Reusable search bookkeeping owned by the grid.
+	 * @return An array of tile coordinates representing the path from start to end.
+	 */
+	static TArray<FGridCoord> GetPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied, FGridSearchScratch& Scratch);
+
+	/**
+	 * Finds a shortest path with Jump Point Search for 4-connected uniform-cost grids.
+	 * Among equally short paths, canonical ones move vertically first and only turn off a horizontal run where
+	 * an obstacle forces it, so only the cells where a path may turn are pushed on the open list.
+	 * Paths have the same length as GetPath's, though not always its number of turns.
+	 * Pruning relies on every step costing the same, so grids with movement costs are searched with GetPath.
+	 * @param Grid - The grid data.
+	 * @param StartTile - The coordinate of the starting tile.
+	 * @param EndTile - The coordinate of the destination tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param Scratch - Reusable search bookkeeping owned by the grid.
+	 * @return An array of tile coordinates representing the path from start to end.
 	 */
-	static TArray<FString> GetPath(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const FString& StartTile, const FString& EndTile, int32 GridSizeX, int32 GridSizeY, float TileSize, const TArray<FString>& OccupiedTiles);
+	static TArray<FGridCoord> GetJumpPointPath(const FGridData& Grid, const FGridCoord& StartTile, const FGridCoord& EndTile, const TBitArray<>& Occupied, FGridSearchScratch& Scratch);
 
 	/**
-	 * Finds all tiles within a specified range from a center tile using BFS.
-	 * @param TileMap - The map of tile names to tile objects.
-	 * @param CenterTile - The name of the center tile.
+	 * Finds all tiles within a specified range from a center tile, in row-major order.
+	 * With obstacles considered this is the set of GetReach: the tiles reachable with Size movement points;
+	 * otherwise the area is the Manhattan diamond around the center, clipped to the grid.
+	 * @param Grid - The grid data.
+	 * @param CenterTile - The coordinate of the center tile.
 	 * @param Size - The maximum distance (in tiles) from the center tile.
 	 * @param ConsiderObstacles - Whether to consider obstacles and occupied tiles.
-	 * @param GridSizeX - The width of the grid.
-	 * @param GridSizeY - The height of the grid.
-	 * @param TileSize - The size of each tile in world units.
-	 * @param OccupiedTiles - A list of tiles that are currently occupied and cannot be traversed.
-	 * @return An array of tile names representing the reachable area.
-	 */
-	static TArray<FString> GetArea(const TMap<FString, TWeakObjectPtr<ATile>>& TileMap, const FString& CenterTile, const int32 Size, const bool ConsiderObstacles, const int32 GridSizeX, const int32 GridSizeY, const float TileSize, const TArray<FString>& OccupiedTiles);
-};
\ No newline at end of file
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param Scratch - Reusable flood fill buffers owned by the grid.
+	 * @return A view of the tile coordinates representing the reachable area, valid until the next query using Scratch.
+	 */
+	static TConstArrayView<FGridCoord> GetArea(const FGridData& Grid, const FGridCoord& CenterTile, const int32 Size, const bool ConsiderObstacles, const TBitArray<>& Occupied, FGridFloodScratch& Scratch);
+
+	/**
+	 * Collects the tiles a unit can reach from a tile with a number of movement points, the tile itself included.
+	 * Uniform-cost grids dilate the tile through the free tiles on a bitboard; grids with movement costs run a
+	 * Dijkstra bounded by the points, with a bucket queue.
+	 * @param Grid - The grid data.
+	 * @param Center - The flat index of the tile; it may be occupied, an obstacle reaches nothing.
+	 * @param Range - The movement points.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param Scratch - Reusable buffers; the result is Scratch.Reach.
+	 * @return The reachable tiles, valid until the next query using Scratch.
+	 */
+	static const FGridBitboard& GetReach(const FGridData& Grid, const int32 Center, const int32 Range, const TBitArray<>& Occupied, FGridFloodScratch& Scratch);
+
+	/**
+	 * Computes the movement points needed to reach every tile of the grid from a source tile, with a full Dijkstra
+	 * over a bucket queue (a plain BFS on uniform-cost grids). Obstacles and occupied tiles are never entered,
+	 * except for the source itself which may be occupied by the unit the field belongs to.
+	 * @param Grid - The grid data.
+	 * @param Source - The flat index of the source tile.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param OutDistance - Receives one distance per cell, or INDEX_NONE for cells that cannot be reached.
+	 * @param Queue - Reusable queue storage.
+	 */
+	static void GetDistanceField(const FGridData& Grid, const int32 Source, const TBitArray<>& Occupied, TArray<int32>& OutDistance, FGridBucketQueue& Queue);
+
+	/**
+	 * Builds the shortest-path tree of a source tile with a Dijkstra bounded by a number of movement points, so that
+	 * the path to every tile in range is then a parent walk (e.g. to preview the move to the tile under the cursor).
+	 * Obstacles and occupied tiles are never entered, except for the source itself.
+	 * @param Grid - The grid data.
+	 * @param Source - The flat index of the source tile.
+	 * @param Range - The movement points.
+	 * @param Occupied - A per-cell mask of tiles that are currently occupied and cannot be traversed.
+	 * @param OutTree - Receives the tree; its buffers are reused.
+	 */
+	static void GetPathTree(const FGridData& Grid, const int32 Source, const int32 Range, const TBitArray<>& Occupied, FGridPathTree& OutTree);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/BattleRules.h"
+
+/**
+ * EBattleActionKind is what a battle action record describes.
+ */
+enum class EBattleActionKind : uint8
+{
+	Move, // A unit moved from one tile to another.
+	Attack // A unit attacked the unit on another tile, possibly taking a counter-attack.
+};
+
+/**
+ * FBattleActionRecord is a compact, plain-data description of one move or attack of the battle, broadcast by
+ * UBattleManager after every action. It holds no strings or actor references: readers that show it as text
+ * (the battle log) format it when it is displayed, and headless tools can build the same records from an FBattleState.
+ */
+struct PAA_API FBattleActionRecord
+{
+	EBattleActionKind Kind = EBattleActionKind::Move; // The kind of action.
+	bool bPlayerTeam = false; // Whether the acting unit belongs to the player.
+	EUnitTypes UnitType = EUnitTypes::None; // The type of the acting unit.
+	EUnitTypes TargetType = EUnitTypes::None; // The type of the attacked unit.
+	FGridCoord From; // The tile the acting unit stood on.
+	FGridCoord To; // The destination of a move, or the tile of the attacked unit.
+	int32 Damage = -1; // The damage dealt by an attack, -1 for a move.
+	int32 CounterDamage = -1; // The counter-attack damage taken by the attacker, or -1 if there was none.
+
+	/**
+	 * Describes a move that was just applied to a battle state.
+	 * @param State - The battle state after the move.
+	 * @param Unit - The index of the unit that moved.
+	 * @param From - The tile the unit moved from.
+	 * @return The record of the move.
+	 */
+	static FBattleActionRecord MakeMove(const FBattleState& State, const int32 Unit, const FGridCoord& From);
+
+	/**
+	 * Describes an attack that was just applied to a battle state.
+	 * @param State - The battle state after the attack.
+	 * @param Unit - The index of the attacker.
+	 * @param Target - The index of the defender.
+	 * @param Result - The damage rolled by the attack.
+	 * @return The record of the attack.
+	 */
+	static FBattleActionRecord MakeAttack(const FBattleState& State, const int32 Unit, const int32 Target, const FBattleAttackResult& Result);
+
+	/** @return True if the attacker took counter-attack damage. */
+	bool WasCountered() const { return Kind == EBattleActionKind::Attack && CounterDamage > 0; }
+};
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Systems/BattleRules.h"
+
+/**
+ * EReplayRecord is the kind of a replay record, stored in the top two bits of its packed word.
+ */
+enum class EReplayRecord : uint8
+{
+	Place, // A unit was placed: unit index and cell.
+	Move, // A unit moved: unit index and destination cell.
+	Attack, // A unit attacked: unit index, target index, damage and counter-attack damage.
+	Turn // A battle turn started: the acting team.
+};
+
+/**
+ * FReplayAction is a replay record unpacked into its fields; fields a record kind does not use are left at their defaults.
+ */
+struct PAA_API FReplayAction
+{
+	EReplayRecord Type = EReplayRecord::Place; // The kind of record.
+	int32 Unit = INDEX_NONE; // The acting (or placed) unit.
+	int32 Target = INDEX_NONE; // The attacked unit.
+	int32 Cell = INDEX_NONE; // The flat index of the placement or destination cell.
+	int32 Damage = -1; // The damage dealt by an attack.
+	int32 CounterDamage = -1; // The counter-attack damage, or -1 if there was none.
+	bool bPlayerTurn = false; // The team acting from a Turn record on.
+};
+
+/**
+ * FBattleReplay is the binary log of a match: the match seed, the battle terrain, the placed units
+ * and one packed 32-bit word per placement, move, attack and turn, each with its time.
+ * Recording an action is a couple of array appends, so it is always on.
+ * Since every random draw of the battle comes from the match seed, the log is enough to re-execute the match,
+ * either headless on an FBattleState (Simulate) or with the actors through UReplayManager.
+ */
+struct PAA_API FBattleReplay
+{
+	int32 Seed = 0; // The match seed; the battle's damage stream derives from it.
+	int32 SizeX = 0; // The width of the grid.
+	int32 SizeY = 0; // The height of the grid.
+	TBitArray<> Obstacles; // The obstacle mask the battle was fought on.
+	TArray<uint8> MovementCost; // The movement cost of every cell, or empty if every cell cost 1.
+	TArray<FBattleUnitDesc> Units; // Type, team and stats of every placed unit, indexed like the battle state (positions come from the Place records).
+	TArray<uint32> Records; // One packed word per action, in the order they happened.
+	TArray<uint32> TimesMs; // When each record happened, in milliseconds since the recording started.
+
+	/**
+	 * Clears the log and starts a new recording.
+	 * @param InSeed - The match seed.
+	 * @param Grid - The grid the match is played on.
+	 */
+	void Start(const int32 InSeed, const FGridData& Grid);
+
+	/**
+	 * Stores the terrain the battle is fought on (obstacles are generated after the recording starts).
+	 * @param Grid - The grid the battle is fought on.
+	 */
+	void SetTerrain(const FGridData& Grid);
+
+	/**
+	 * Records a placed unit.
+	 * @param Unit - The index of the unit in the battle state.
+	 * @param Desc - The unit, as added to the battle state.
+	 */
+	void RecordPlace(const int32 Unit, const FBattleUnitDesc& Desc);
+
+	/**
+	 * Records a move.
+	 * @param Unit - The index of the unit.
+	 * @param Tile - The tile the unit ended on.
+	 */
+	void RecordMove(const int32 Unit, const FGridCoord& Tile);
+
+	/**
+	 * Records an attack and its outcome, which playback checks.
+	 * @param Unit - The index of the attacker.
+	 * @param Target - The index of the defender.
+	 * @param Result - The damage dealt and the counter-attack damage.
+	 */
+	void RecordAttack(const int32 Unit, const int32 Target, const FBattleAttackResult& Result);
+
+	/**
+	 * Records the start of a battle turn.
+	 * @param bPlayerTurn - Whether the player's team acts.
+	 */
+	void RecordTurn(const bool bPlayerTurn);
+
+	/**
+	 * Unpacks a record.
+	 * @param Record - The packed word.
+	 * @return The unpacked fields.
+	 */
+	static FReplayAction Decode(const uint32 Record);
+
+	/**
+	 * Returns the coordinate of a record's cell.
+	 * @param Cell - The flat index of the cell.
+	 * @return The coordinate, or an unset coordinate if the cell lies outside the recorded grid.
+	 */
+	FGridCoord ToCoord(const int32 Cell) const;
+
+	/**
+	 * Builds the battle state the recording starts from: the terrain and the damage stream of the match, no units.
+	 * @return The battle state.
+	 */
+	FBattleState MakeInitialState() const;
+
+	/**
+	 * Re-executes the match on a battle state as fast as possible, without a world. Every action is checked
+	 * against the rules and every attack against the recorded damage; playback stops at the first mismatch.
+	 * @param OutState - Receives the state after the last replayed record.
+	 * @return The index of the first record that diverged, or INDEX_NONE if the whole match replayed exactly.
+	 */
+	int32 Simulate(FBattleState& OutState) const;
+
+	/**
+	 * Reads or writes the log.
+	 * @param Ar - The archive.
+	 * @return False if a loaded log is not a replay or has an unsupported version.
+	 */
+	bool Serialize(FArchive& Ar);
+
+	/**
+	 * Writes the log to a file.
+	 * @param Filename - The file to write.
+	 * @return True if the file was written.
+	 */
+	bool SaveToFile(const FString& Filename);
+
+	/**
+	 * Reads a log from a file.
+	 * @param Filename - The file to read.
+	 * @return True if the file holds a valid replay.
+	 */
+	bool LoadFromFile(const FString& Filename);
+
+private:
+	/**
+	 * Appends a packed word and its time.
+	 * @param Record - The packed word.
+	 */
+	void Add(const uint32 Record);
+
+	double StartSeconds = 0.0; // When the recording started.
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/Utils/PathfindingUtilities.h"
+#include "Systems/BattleState.h"
+
+/**
+ * FBattleAttackResult is the outcome of an attack; -1 means "did not happen", as in the battle log.
+ */
+struct PAA_API FBattleAttackResult
+{
+	int32 Damage = -1; // The damage dealt to the defender.
+	int32 CounterDamage = -1; // The counter-attack damage dealt to the attacker, or -1 if there was none.
+};
+
+/**
+ * FBattleUndo records what an applied action changed, so the action can be taken back exactly.
+ */
+struct PAA_API FBattleUndo
+{
+	int32 Unit = INDEX_NONE; // The acting unit.
+	int32 Target = INDEX_NONE; // The attacked unit, or INDEX_NONE for a move.
+	FGridCoord From; // The tile the acting unit stood on.
+	EActionType Action = EActionType::None; // The action of the acting unit before this one.
+	int32 UnitLifePoints = 0; // The life points of the acting unit before the action.
+	int32 TargetLifePoints = 0; // The life points of the target before the action.
+	FMatchRng Random; // The random stream before the action.
+};
+
+/**
+ * FBattleRules applies the battle rules to an FBattleState: which moves and attacks are legal, how damage and
+ * counter-attacks are rolled, and how turns pass. It mirrors what UBattleManager does with the unit actors,
+ * and UBattleManager drives its own state through it, so simulated and played battles cannot diverge.
+ * An instance owns reusable search buffers and must not be shared between threads.
+ */
+struct PAA_API FBattleRules
+{
+	/**
+	 * Returns whether a unit may move this turn, regardless of the destination.
+	 * @param State - The battle state.
+	 * @param Unit - The index of the unit.
+	 * @return True if the unit is alive, belongs to the acting team and has not acted yet.
+	 */
+	static bool CanAct(const FBattleState& State, const int32 Unit);
+
+	/**
+	 * Returns whether a unit may move to a tile: it must be able to act and reach the tile within its movement range.
+	 * @param State - The battle state.
+	 * @param Unit - The index of the unit.
+	 * @param Tile - The destination.
+	 * @return True if the move is legal.
+	 */
+	bool CanMove(const FBattleState& State, const int32 Unit, const FGridCoord& Tile);
+
+	/**
+	 * Returns whether a unit may attack another one: it must belong to the acting team, not have attacked yet,
+	 * and the target must be an enemy within its attack range, in line of sight (obstacles block shots, units do not).
+	 * @param State - The battle state.
+	 * @param Unit - The index of the attacker.
+	 * @param Target - The index of the defender.
+	 * @return True if the attack is legal.
+	 */
+	static bool CanAttack(const FBattleState& State, const int32 Unit, const int32 Target);
+
+	/**
+	 * Collects every tile a unit may move to this turn.
+	 * @param State - The battle state.
+	 * @param Unit - The index of the unit.
+	 * @param OutTiles - Receives the destinations (empty if the unit cannot move).
+	 */
+	void GetMoves(const FBattleState& State, const int32 Unit, TArray<FGridCoord>& OutTiles);
+
+	/**
+	 * Moves a unit; the move is expected to be legal (see CanMove). Moving to the unit's own tile only spends the move.
+	 * @param State - The battle state.
+	 * @param Unit - The index of the unit.
+	 * @param Tile - The destination.
+	 * @param OutUndo - Receives what is needed to take the move back.
+	 */
+	static void ApplyMove(FBattleState& State, const int32 Unit, const FGridCoord& Tile, FBattleUndo& OutUndo);
+
+	/**
+	 * Resolves an attack; the attack is expected to be legal (see CanAttack).
+	 * Damage is rolled from the unit's damage range. A sniper attacking is countered for 1-3 damage,
+	 * unless the defender is a brawler that is not adjacent to it. Units reaching zero life points free their tile.
+	 * @param State - The battle state.
+	 * @param Unit - The index of the attacker.
+	 * @param Target - The index of the defender.
+	 * @param OutUndo - Receives what is needed to take the attack back.
+	 * @return The damage dealt and the counter-attack damage.
+	 */
+	static FBattleAttackResult ApplyAttack(FBattleState& State, const int32 Unit, const int32 Target, FBattleUndo& OutUndo);
+
+	/**
+	 * Takes back a move or an attack. Actions must be undone in the reverse order they were applied.
+	 * @param State - The battle state.
+	 * @param Undo - The record returned when the action was applied.
+	 */
+	static void Undo(FBattleState& State, const FBattleUndo& Undo);
+
+	/**
+	 * Ends the turn: the acting team's actions are reset and the other team acts.
+	 * Turns are not undoable; copy the state instead.
+	 * @param State - The battle state.
+	 */
+	static void EndTurn(FBattleState& State);
+
+private:
+	/**
+	 * Builds the set of tiles a unit can walk to with its movement points into Flood.Reach, its own tile included.
+	 * @param State - The battle state.
+	 * @param Unit - The index of the unit.
+	 */
+	void BuildReach(const FBattleState& State, const int32 Unit);
+
+	FGridFloodScratch Flood; // Reusable buffers of the movement range search; Flood.Reach holds the last range built.
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/GridTypes.h"
+#include "Grid/GridVisibility.h"
+#include "Units/UnitTypes.h"
+#include "Game/MatchRandom.h"
+#include "BattleState.generated.h"
+
+UENUM()
+enum class EActionType : int8 { None, Move, Attack, MoveAndAttack }; // Represents the type of action a unit can perform.
+
+/**
+ * FBattleUnitDesc describes a unit entering the battle.
+ */
+struct PAA_API FBattleUnitDesc
+{
+	EUnitTypes Type = EUnitTypes::None; // The unit type (decides counter-attacks).
+	bool bPlayerTeam = false; // Whether the unit belongs to the player.
+	FGridCoord Position; // The tile the unit stands on.
+	int32 LifePoints = 0; // The current life points.
+	int32 MovementRange = 0; // The maximum number of steps per move.
+	int32 AttackRange = 0; // The maximum Manhattan distance of an attack.
+	int32 DamageMin = 0; // The minimum damage of an attack.
+	int32 DamageMax = 0; // The maximum damage of an attack.
+};
+
+/**
+ * FBattleUnits stores every unit of a battle as a struct of arrays; a unit is an index shared by all arrays.
+ * Units are never removed: a dead unit keeps its slot with zero life points, so indices stay stable.
+ */
+struct PAA_API FBattleUnits
+{
+	TArray<EUnitTypes> Type; // The type of each unit.
+	TBitArray<> PlayerTeam; // One bit per unit, set for the player's units.
+	TArray<FGridCoord> Position; // The tile each unit stands on.
+	TArray<int32> LifePoints; // The current life points of each unit.
+	TArray<int32> MovementRange; // The maximum number of steps per move of each unit.
+	TArray<int32> AttackRange; // The maximum Manhattan distance of an attack of each unit, in line of sight.
+	TArray<int32> DamageMin; // The minimum damage of each unit.
+	TArray<int32> DamageMax; // The maximum damage of each unit.
+	TArray<EActionType> Action; // The action each unit performed this turn.
+
+	/** @return The number of units, dead ones included. */
+	int32 Num() const { return Type.Num(); }
+
+	/** @return True if the unit has life points left. */
+	bool IsAlive(const int32 Unit) const { return LifePoints[Unit] > 0; }
+
+	/** @return True if the unit belongs to the player. */
+	bool IsPlayer(const int32 Unit) const { return PlayerTeam[Unit]; }
+};
+
+/**
+ * FBattleState is the complete, plain-data state of a battle: terrain, occupancy, units, turn and random stream.
+ * It holds no UObject references, so it can be copied, simulated and undone without a world.
+ */
+struct PAA_API FBattleState
+{
+	FGridData Grid; // Grid dimensions, obstacles and movement costs; tile handles are left empty.
+	TBitArray<> Occupied; // One bit per cell, set where a living unit stands.
+	FBattleUnits Units; // Every unit of the battle.
+	bool bPlayerTurn = true; // Whether the player's team is acting.
+	FMatchRng Random; // The stream every damage roll is drawn from.
+	TSharedPtr<const FGridVisibility> Visibility; // Line of sight cached from the obstacles; shared by every copy, as the terrain never changes mid-battle.
+
+	/**
+	 * Removes every unit and copies the terrain of a grid.
+	 * @param InGrid - The grid the battle is fought on.
+	 */
+	void Reset(const FGridData& InGrid);
+
+	/**
+	 * Copies the obstacles and movement costs of a grid of the same size, keeping the units,
+	 * and caches the line of sight of the new obstacles.
+	 * @param InGrid - The grid the battle is fought on.
+	 */
+	void SetTerrain(const FGridData& InGrid);
+
+	/**
+	 * Returns whether two tiles see each other over the obstacles; units never block the view.
+	 * @param From - The coordinate of the first tile.
+	 * @param To - The coordinate of the second tile.
+	 * @return True if no obstacle lies between the two tiles.
+	 */
+	bool HasLineOfSight(const FGridCoord& From, const FGridCoord& To) const;
+
+	/**
+	 * Adds every tile within a Manhattan range of a tile that sees it.
+	 * @param Center - The coordinate of the tile.
+	 * @param Range - The Manhattan range.
+	 * @param InOutArea - The set receiving the tiles; must have the size of the grid.
+	 */
+	void AddVisibleArea(const FGridCoord& Center, const int32 Range, FGridBitboard& InOutArea) const;
+
+	/**
+	 * Adds a unit and marks its tile as occupied.
+	 * @param Desc - The unit to add.
+	 * @return The index of the unit.
+	 */
+	int32 AddUnit(const FBattleUnitDesc& Desc);
+
+	/**
+	 * Finds the living unit standing on a tile.
+	 * @param Tile - The coordinate of the tile.
+	 * @return The index of the unit, or INDEX_NONE if the tile is free.
+	 */
+	int32 FindUnitAt(const FGridCoord& Tile) const;
+
+	/**
+	 * Returns whether every unit of a team is dead.
+	 * @param bPlayerTeam - The team to check.
+	 * @return True if the team has no living unit.
+	 */
+	bool IsTeamDefeated(const bool bPlayerTeam) const;
+};
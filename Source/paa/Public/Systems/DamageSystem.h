@@ -2,11 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "Units/BaseUnit.h"
-#include "Units/SniperUnit.h"
+#include "Systems/BattleRules.h"
 #include "DamageSystem.generated.h"
 
 /**
- * System responsible for handling damage calculations and counter-attacks between units.
+ * System responsible for applying the damage of an attack, resolved by FBattleRules, to the unit actors.
  */
 UCLASS()
 class PAA_API UDamageSystem : public UObject
@@ -15,18 +15,10 @@ class PAA_API UDamageSystem : public UObject
 
 public:
 	/**
-	 * Applies damage from an attacker to a defender and handles counter-attacks if applicable.
-	 * @param Attacker - The unit initiating the attack.
+	 * Applies the damage of a resolved attack to the attacker and the defender.
+	 * @param Attacker - The unit initiating the attack (takes the counter-attack damage, if any).
 	 * @param Defender - The unit receiving the attack.
-	 * @return A pair of integers representing the damage dealt and the counter-attack damage (if any).
+	 * @param Result - The damage rolled by FBattleRules::ApplyAttack.
 	 */
-	static TPair<int32, int32> ApplyDamage(const TWeakObjectPtr<ABaseUnit> Attacker, const TWeakObjectPtr<ABaseUnit> Defender);
-
-private:
-	/**
-	 * Handles counter-attack logic for sniper units.
-	 * @param Attacker - The sniper unit initiating the counter-attack.
-	 * @return The damage dealt by the counter-attack.
-	 */
-	static int32 ApplyCounterAttack(const TWeakObjectPtr<ASniperUnit> Attacker);
+	static void ApplyDamage(const TWeakObjectPtr<ABaseUnit> Attacker, const TWeakObjectPtr<ABaseUnit> Defender, const FBattleAttackResult& Result);
 };
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grid/Utils/PathfindingUtilities.h"
+#include "Systems/BattleState.h"
+
+/** The layers of an FInfluenceMap. */
+enum class EInfluenceLayer : uint8
+{
+	Threat, // The damage the enemies could deal to each tile next turn.
+	Support, // How closely each tile is backed by allies.
+	TargetDistance // The walking distance from each tile to the nearest enemy.
+};
+
+/**
+ * FInfluenceMap layers, over the flat grid, what a team weighs when positioning its units: the threat of the enemy
+ * team (the damage of every enemy that could walk to a tile and shoot from there next turn), the support of its own
+ * team (allies nearby, fading with distance) and the walking distance to the nearest enemy.
+ * Threat and support are sums of per-unit stamps, so a unit that moves or dies only takes its own stamp back and
+ * applies it again; the distance layer is a single multi-source Dijkstra, redone when an enemy moves or dies.
+ * A threat stamp reflects the occupancy at the time it was made, so the map is rebuilt at the start of every turn.
+ * An instance owns reusable search buffers and must not be shared between threads.
+ */
+struct PAA_API FInfluenceMap
+{
+	static constexpr int32 SupportRadius = 3; // The Manhattan radius an ally supports tiles within.
+
+	/**
+	 * Computes every layer from scratch.
+	 * @param State - The battle state.
+	 * @param bInPlayerTeam - The team the map scores tiles for; the other team is the enemy.
+	 */
+	void Build(const FBattleState& State, const bool bInPlayerTeam);
+
+	/**
+	 * Brings the map up to date after a unit moved or died, replacing only that unit's contribution.
+	 * Does nothing if the unit is still where it was stamped.
+	 * @param State - The battle state the map was built from, after the change.
+	 * @param Unit - The index of the unit.
+	 */
+	void UpdateUnit(const FBattleState& State, const int32 Unit);
+
+	/** @return True if the map was built and can be read. */
+	bool IsBuilt() const { return Threat.Num() > 0; }
+
+	/** @return The team the map scores tiles for. */
+	bool IsPlayerTeam() const { return bPlayerTeam; }
+
+	/** @return The sum of DamageMin + DamageMax of every enemy that threatens a cell. */
+	int32 GetThreat(const int32 Cell) const { return Threat[Cell]; }
+
+	/**
+	 * Returns the support of a cell, leaving out one unit (e.g. the unit deciding where to go).
+	 * @param Cell - The flat index of the cell.
+	 * @param ExcludeUnit - The index of the unit to leave out, or INDEX_NONE.
+	 * @return The sum, over allies within SupportRadius, of SupportRadius + 1 minus their distance.
+	 */
+	int32 GetSupport(const int32 Cell, const int32 ExcludeUnit = INDEX_NONE) const;
+
+	/** @return The movement points between a cell and the nearest enemy, ignoring units; INDEX_NONE if walls cut it off. */
+	int32 GetTargetDistance(const int32 Cell) const { return TargetDistance[Cell]; }
+
+	/** @return One value per cell of a layer. */
+	TConstArrayView<int32> GetLayer(const EInfluenceLayer Layer) const;
+
+private:
+	/** Adds the threat stamp of an enemy standing on its current tile. */
+	void StampThreat(const FBattleState& State, const int32 Unit);
+
+	/**
+	 * Adds or removes the support stamp of an ally.
+	 * @param Grid - The grid data.
+	 * @param Center - The tile the ally stands on.
+	 * @param Sign - 1 to add the stamp, -1 to remove it.
+	 */
+	void StampSupport(const FGridData& Grid, const FGridCoord& Center, const int32 Sign);
+
+	/** Recomputes the distance layer from every living enemy at once. */
+	void BuildTargetDistance(const FBattleState& State);
+
+	bool bPlayerTeam = false; // The team the map scores tiles for.
+
+	int32 SizeX = 0; // The width of the grid the map was built on.
+
+	TArray<int32> Threat; // The threat layer, one value per cell.
+
+	TArray<int32> Support; // The support layer, one value per cell.
+
+	TArray<int32> TargetDistance; // The distance layer, one value per cell.
+
+	TBitArray<> Enemies; // One bit per unit, set for the units of the enemy team.
+
+	TArray<FGridCoord> Stamped; // The tile each unit's stamp was made from; unset if the unit has no stamp.
+
+	TArray<TArray<int32>> ThreatCells; // The cells each enemy's threat stamp covers.
+
+	FGridFloodScratch Flood; // Reusable buffers of an enemy's walking range.
+
+	FGridBitboard Strike; // Reusable set of the tiles an enemy could shoot.
+
+	FGridBucketQueue Queue; // Reusable queue of the distance layer.
+};
@@ -17,7 +17,16 @@ public:
 	 * Applies movement to a unit, moving it to the specified end tile while avoiding occupied tiles.
 	 * @param Mover - The unit to move.
 	 * @param EndTile - The target tile to move to.
-	 * @param OccupiedTiles - List of tiles currently occupied by other units or obstacles.
+	 * @param Occupied - A per-cell mask of tiles currently occupied by units.
+	 * @param GridManager - The grid whose cached distance fields are invalidated by the occupancy change.
 	 */
-	static void ApplyMovement(const TWeakObjectPtr<ABaseUnit> Mover, const FString& EndTile, const TArray<FString>& OccupiedTiles);
+	static void ApplyMovement(const TWeakObjectPtr<ABaseUnit> Mover, const FGridCoord& EndTile, const TBitArray<>& Occupied, const AGridManager* GridManager);
+
+	/**
+	 * Applies movement to a unit along a path found beforehand (e.g. the one previewed to the player).
+	 * @param Mover - The unit to move.
+	 * @param Path - The tiles from the unit's tile to the target tile.
+	 * @param GridManager - The grid whose cached distance fields are invalidated by the occupancy change.
+	 */
+	static void ApplyMovement(const TWeakObjectPtr<ABaseUnit> Mover, TArray<FGridCoord>&& Path, const AGridManager* GridManager);
 };
\ No newline at end of file
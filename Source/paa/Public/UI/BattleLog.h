@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "Blueprint/UserWidget.h"
+#include "Components/TextBlock.h"
+#include "Grid/GridManager.h"
+#include "Systems/BattleActionRecord.h"
+#include "BattleLog.generated.h"
+
+/**
+ * UBattleLogItem is one row of the battle log. The log keeps a fixed number of items in a ring and reuses the
+ * oldest one for every new event once it is full, so a long match allocates no new rows.
+ * A row holds the action record rather than its text; the text is only built when an entry widget shows the row.
+ */
+UCLASS()
+class PAA_API UBattleLogItem : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Formats an action as a line of the battle log.
+	 * @param Record - The action.
+	 * @param bCounterAttack - True for the line of the counter-attack an attacker took, false for the action itself.
+	 * @param GridManager - The grid manager naming the tiles; tiles are left unnamed if null.
+	 * @return The text of the line.
+	 */
+	static FString Describe(const FBattleActionRecord& Record, const bool bCounterAttack, const AGridManager* GridManager);
+
+	/** @return The text of this row. */
+	FString GetText() const { return Describe(Record, bCounterAttack, GridManager.Get()); }
+
+	FBattleActionRecord Record; // The action of the row.
+
+	bool bCounterAttack = false; // Whether the row shows the counter-attack of Record rather than the action.
+
+	TWeakObjectPtr<const AGridManager> GridManager; // The grid manager naming the tiles of the row.
+};
+
+/**
+ * UBattleLogEntry displays one UBattleLogItem inside the log's list view. The list view only creates entries for
+ * the rows on screen and hands them new items as the list scrolls, so the layout cost does not grow with the log.
+ * The native class builds a single text block; a widget blueprint of it may lay out its own TextBlock_Event instead.
+ */
+UCLASS()
+class PAA_API UBattleLogEntry : public UUserWidget, public IUserObjectListEntry
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void NativeOnInitialized() override;
+
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+
+private:
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* TextBlock_Event;
+};
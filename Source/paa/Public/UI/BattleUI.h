@@ -5,12 +5,14 @@
 #include "Components/Button.h"
 #include "Components/CanvasPanel.h"
 #include "Components/Image.h"
+#include "Components/ListView.h"
 #include "Components/ProgressBar.h"
 #include "Components/ScrollBox.h"
 #include "Components/TextBlock.h"
 #include "Game/StrategyGameMode.h"
 #include "Game/Managers/BattleManager.h"
 #include "Units/BaseUnit.h"
+#include "UI/BattleLog.h"
 #include "BattleUI.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEndSignal, bool, bIsPlayerVictory);
@@ -24,6 +26,8 @@ class PAA_API UBattleUI : public UUserWidget
 	GENERATED_BODY()
 
 public:
+	virtual void NativeOnInitialized() override;
+
 	UFUNCTION()
 	virtual void NativeConstruct() override;
 
@@ -79,8 +83,19 @@ private:
 	UPROPERTY(meta = (BindWidget))
 	UImage* Image_UnitSelected;
 
-	UPROPERTY(meta = (BindWidget))
-	UScrollBox* ScrollBox_Events;
+	UPROPERTY(meta = (BindWidgetOptional))
+	UListView* ListView_Events; // The virtualized event log; built in place of ScrollBox_Events when the layout has none.
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UScrollBox* ScrollBox_Events; // The placeholder of the event log in layouts without ListView_Events.
+
+	UPROPERTY(EditAnywhere, Category = "Battle Log", meta = (ClampMin = "1"))
+	int32 MaxLogEntries = 200; // The number of most recent events the log keeps.
+
+	UPROPERTY()
+	TArray<UBattleLogItem*> LogItems; // The log's rows as a ring buffer, the oldest at LogHead once full.
+
+	int32 LogHead = 0; // The ring slot holding the oldest row once the log is full.
 
 	UPROPERTY(meta = (BindWidget))
 	UButton* Button_NextTurn;
@@ -97,9 +112,6 @@ private:
 	UPROPERTY()
 	TWeakObjectPtr<AStrategyGameMode> GameMode;
 
-	UPROPERTY()
-	TArray<TWeakObjectPtr<UTexture2D>> Textures;
-
 	UPROPERTY()
 	bool bIsPlayerTurn = false;
 	UPROPERTY()
@@ -116,8 +128,11 @@ private:
 	UFUNCTION()
 	void OnUnitSelected(ABaseUnit* Unit, bool bIsPlayerUnit);
 
-	UFUNCTION()
-	void OnActionExecuted(const FString Text);
+	void OnBattleAction(const FBattleActionRecord& Record); // Adds an action to the event log, plus a row for its counter-attack.
+
+	void AddLogRow(const FBattleActionRecord& Record, const bool bCounterAttack); // Appends one row to the event log.
+
+	void ClearLog(); // Empties the event log.
 
 	UFUNCTION()
 	void OnCanSkipTurn(const bool bCanSkipTurn);
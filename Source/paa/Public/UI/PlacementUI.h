@@ -61,7 +61,15 @@ private:
 	
 	TWeakObjectPtr<AStrategyGameMode> GameMode;
 
-	TArray<TWeakObjectPtr<UTexture2D>> Textures;
+	EUnitTypes ShownUnitType = EUnitTypes::None; // The unit type whose details are shown.
+
+	/**
+	 * Shows the texture of the unit type whose details are shown, if it is loaded.
+	 */
+	void ShowUnitTexture();
+
+	UFUNCTION()
+	void OnUnitVisualsReady();
 	
 	UFUNCTION()
 	void OnSniperButtonClicked();
@@ -3,24 +3,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Grid/GridManager.h"
+#include "Units/UnitTypes.h"
 #include "BaseUnit.generated.h"
 
-UENUM()
-enum class EUnitTypes : uint8
-{
-	None,
-	Brawler,
-	Sniper,
-};
-
-UENUM()
-enum class EAttackType : uint8
-{
-	Melee,
-	Ranged,
-};
-
-
 /**
  * @brief The base class for all unit types in the game.
  * 
@@ -39,14 +24,14 @@ public:
 	UFUNCTION()
 	void SetTextureColor(const int32 ColorIndex);
 	UFUNCTION()
-	void SetUnitPosition(const FString& UnitPosition);
+	void SetUnitPosition(const FGridCoord& UnitPosition);
 
 	UFUNCTION()
 	UMaterialInstanceDynamic* GetMaterial() const;
 	UFUNCTION()
 	int32 GetTextureColor() const;
 	UFUNCTION()
-	FString GetPosition() const;
+	FGridCoord GetPosition() const;
 	UFUNCTION()
 	int32 GetMovementRange() const;
 	UFUNCTION()
@@ -61,11 +46,9 @@ public:
 	int32 GetMaxDamage() const;
 	UFUNCTION()
 	int32 GetMinDamage() const;
-	UFUNCTION()
-	int32 GetDamage() const;
 	
-	UFUNCTION()
-	void FollowPath(const FString& EndTile, const TArray<FString>& OccupiedTiles);
+	void FollowPath(const FGridCoord& EndTile, const TBitArray<>& Occupied);
+	void FollowPath(TArray<FGridCoord>&& Path); // Walks a path found beforehand, from the unit's tile to its destination.
 	UFUNCTION()
 	void GetDamaged(const int32 Damage);
 
@@ -74,7 +57,7 @@ public:
 	UFUNCTION()
 	bool IsMoving() const;
 	UFUNCTION()
-	bool IsNeighbour(const FString& TileName) const;
+	bool IsNeighbour(const FGridCoord& Tile) const;
 		
 protected:
 	UFUNCTION()
@@ -96,10 +79,10 @@ protected:
 	int32 TextureIndex = 0;
 
 	UPROPERTY(VisibleAnywhere)
-	FString UnitPosition = "";
+	FGridCoord UnitPosition;
 	
 	UPROPERTY(VisibleAnywhere)
-	TArray<FString> CurrentPath = {};
+	TArray<FGridCoord> CurrentPath = {};
 
 	UPROPERTY(VisibleAnywhere)
 	int32 CurrentPathIndex = 0;
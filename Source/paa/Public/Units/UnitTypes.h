@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UnitTypes.generated.h"
+
+UENUM()
+enum class EUnitTypes : uint8
+{
+	None,
+	Brawler,
+	Sniper,
+};
+
+UENUM()
+enum class EAttackType : uint8
+{
+	Melee,
+	Ranged,
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/Texture2D.h"
+#include "Units/UnitTypes.h"
+#include "UnitVisualsAsset.generated.h"
+
+/**
+ * UUnitVisualsAsset lists the textures of every unit type, one per team color, as soft references: holding the asset
+ * loads none of them. UUnitVisualsManager streams them in asynchronously and shares them with everything that draws units.
+ */
+UCLASS(BlueprintType)
+class PAA_API UUnitVisualsAsset : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Returns the textures of a unit type.
+	 * @param Type - The unit type.
+	 * @return One texture per team color, in the order of the color buttons.
+	 */
+	const TArray<TSoftObjectPtr<UTexture2D>>& GetTextures(const EUnitTypes Type) const;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Units")
+	TArray<TSoftObjectPtr<UTexture2D>> SniperTextures; // The sniper's texture for every team color.
+
+	UPROPERTY(EditDefaultsOnly, Category = "Units")
+	TArray<TSoftObjectPtr<UTexture2D>> BrawlerTextures; // The brawler's texture for every team color.
+};